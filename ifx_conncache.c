@@ -198,6 +198,12 @@ ifxConnCache_add(Oid foreignTableOid, IfxConnectionInfo *coninfo, bool *found)
 		/* also initialize usage counter */
 		item->con.usage = 1;
 
+		/* no key tables created yet */
+		item->key_tables = NIL;
+
+		/* server version is retrieved when needed */
+		item->server_version = 0;
+
 		MemoryContextSwitchTo(old_cxt);
 	}
 	else
@@ -235,6 +241,80 @@ ifxConnCache_exists(char *conname, bool *found)
 	return ((found) ? item : NULL);
 }
 
+/*
+ * Returns true in case the specified key table was already
+ * created within the session of the given cached connection.
+ */
+bool
+ifxConnCache_hasKeyTable(IfxCachedConnection *item, char *tablename)
+{
+	ListCell *cell;
+
+	foreach(cell, item->key_tables)
+	{
+		if (strcmp((char *) lfirst(cell), tablename) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Remembers the specified key table to exist within the
+ * session of the given cached connection.
+ */
+void
+ifxConnCache_addKeyTable(IfxCachedConnection *item, char *tablename)
+{
+	MemoryContext old_cxt;
+
+	if (ifxConnCache_hasKeyTable(item, tablename))
+		return;
+
+	old_cxt = MemoryContextSwitchTo(TopMemoryContext);
+	item->key_tables = lappend(item->key_tables, pstrdup(tablename));
+	MemoryContextSwitchTo(old_cxt);
+}
+
+/*
+ * Forget the specified key table of the given cached connection,
+ * e.g. after it was dropped.
+ */
+void
+ifxConnCache_removeKeyTable(IfxCachedConnection *item, char *tablename)
+{
+	ListCell *cell;
+	ListCell *prev = NULL;
+
+	foreach(cell, item->key_tables)
+	{
+		char *name = (char *) lfirst(cell);
+
+		if (strcmp(name, tablename) == 0)
+		{
+			item->key_tables = list_delete_cell(item->key_tables, cell, prev);
+			pfree(name);
+			return;
+		}
+
+		prev = cell;
+	}
+}
+
+/*
+ * Forget all key tables of the given cached connection.
+ *
+ * Informix rolls back the creation of a TEMP table along with
+ * the transaction it was created in, so this must be called
+ * whenever the remote transaction is rolled back.
+ */
+void
+ifxConnCache_resetKeyTables(IfxCachedConnection *item)
+{
+	list_free_deep(item->key_tables);
+	item->key_tables = NIL;
+}
+
 /*
  * Remove an existing connection handle from the cache.
  * If the requested connection doesn't exist yet, NULL
@@ -290,7 +370,116 @@ IfxFTCacheItem *ifxFTCache_add(Oid foreignTableOid, char *conname)
 		item->foreignTableOid = foreignTableOid;
 		bzero(item->ifx_connection_name, IFX_CONNAME_LEN);
 		StrNCpy(item->ifx_connection_name, conname, strlen(conname));
+
+		/* index information is retrieved on demand */
+		item->has_index_info = false;
+		item->nindexes       = 0;
+		item->indexes        = NULL;
+
+		/* same for fragments */
+		item->has_fragment_info = false;
+		item->nfragments        = 0;
+		item->fragments         = NULL;
 	}
 
 	return item;
 }
+
+/*
+ * Stores a copy of the specified remote index information
+ * in the given cached foreign table.
+ */
+void ifxFTCache_setIndexInfo(IfxFTCacheItem *item, int nindexes,
+							 IfxIndexInfo *indexes)
+{
+	if (item->indexes != NULL)
+		pfree(item->indexes);
+
+	item->indexes  = NULL;
+	item->nindexes = nindexes;
+
+	if (nindexes > 0)
+	{
+		item->indexes = MemoryContextAlloc(TopMemoryContext,
+										   nindexes * sizeof(IfxIndexInfo));
+		memcpy(item->indexes, indexes, nindexes * sizeof(IfxIndexInfo));
+	}
+
+	item->has_index_info = true;
+}
+
+/*
+ * Forget the cached remote index information of the
+ * specified foreign table, if any. It is retrieved again
+ * the next time the foreign table is planned.
+ */
+void ifxFTCache_resetIndexInfo(Oid foreignTableOid)
+{
+	IfxFTCacheItem *item;
+	bool            found;
+
+	if (!IfxCacheIsInitialized)
+		return;
+
+	item = hash_search(ifxCache.tables, (void *) &foreignTableOid,
+					   HASH_FIND, &found);
+
+	if (found)
+	{
+		if (item->indexes != NULL)
+			pfree(item->indexes);
+
+		item->has_index_info = false;
+		item->nindexes       = 0;
+		item->indexes        = NULL;
+	}
+}
+
+/*
+ * Stores a copy of the specified remote fragment information
+ * in the given cached foreign table.
+ */
+void ifxFTCache_setFragmentInfo(IfxFTCacheItem *item, int nfragments,
+								IfxFragmentInfo *fragments)
+{
+	if (item->fragments != NULL)
+		pfree(item->fragments);
+
+	item->fragments  = NULL;
+	item->nfragments = nfragments;
+
+	if (nfragments > 0)
+	{
+		item->fragments = MemoryContextAlloc(TopMemoryContext,
+											 nfragments * sizeof(IfxFragmentInfo));
+		memcpy(item->fragments, fragments, nfragments * sizeof(IfxFragmentInfo));
+	}
+
+	item->has_fragment_info = true;
+}
+
+/*
+ * Forget the cached remote fragment information of the
+ * specified foreign table, if any.
+ */
+void ifxFTCache_resetFragmentInfo(Oid foreignTableOid)
+{
+	IfxFTCacheItem *item;
+	bool            found;
+
+	if (!IfxCacheIsInitialized)
+		return;
+
+	item = hash_search(ifxCache.tables, (void *) &foreignTableOid,
+					   HASH_FIND, &found);
+
+	if (found)
+	{
+		if (item->fragments != NULL)
+			pfree(item->fragments);
+
+		item->has_fragment_info = false;
+		item->nfragments        = 0;
+		item->fragments         = NULL;
+	}
+}
@@ -33,6 +33,22 @@ typedef struct IfxFTCacheItem
 
 	Oid foreignTableOid;
 
+	/*
+	 * Indexes of the remote table, allocated in TopMemoryContext.
+	 * Only valid if has_index_info is set.
+	 */
+	bool          has_index_info;
+	int           nindexes;
+	IfxIndexInfo *indexes;
+
+	/*
+	 * Fragments of the remote table, allocated in TopMemoryContext.
+	 * Only valid if has_fragment_info is set.
+	 */
+	bool             has_fragment_info;
+	int              nfragments;
+	IfxFragmentInfo *fragments;
+
 	/*
 	 * XXX: Cached cost estimates for this foreign table
 	 */
@@ -46,6 +62,18 @@ typedef struct IfxCachedConnection
 {
 	IfxPGCachedConnection con;
 	Oid establishedByOid;
+
+	/*
+	 * Names of the key tables already created within the
+	 * session of this connection, allocated in TopMemoryContext.
+	 */
+	List *key_tables;
+
+	/*
+	 * Version of the Informix server, e.g. 1150 for 11.50. 0 if
+	 * not retrieved yet, -1 if unknown.
+	 */
+	int server_version;
 } IfxCachedConnection;
 
 /*
@@ -74,11 +102,21 @@ void InformixCacheInit(void);
  * Register a new INFORMIX foreign table to the cache.
  */
 IfxFTCacheItem *ifxFTCache_add(Oid foreignTableOid, char *conname);
+void ifxFTCache_setIndexInfo(IfxFTCacheItem *item, int nindexes,
+							 IfxIndexInfo *indexes);
+void ifxFTCache_resetIndexInfo(Oid foreignTableOid);
+void ifxFTCache_setFragmentInfo(IfxFTCacheItem *item, int nfragments,
+								IfxFragmentInfo *fragments);
+void ifxFTCache_resetFragmentInfo(Oid foreignTableOid);
 IfxCachedConnection *ifxConnCache_add(Oid foreignTableOid,
 									  IfxConnectionInfo *coninfo,
                                       bool *found);
 IfxCachedConnection *ifxConnCache_rm(char *conname,
                                      bool *found);
 IfxCachedConnection *ifxConnCache_exists(char *conname, bool *found);
+bool ifxConnCache_hasKeyTable(IfxCachedConnection *item, char *tablename);
+void ifxConnCache_addKeyTable(IfxCachedConnection *item, char *tablename);
+void ifxConnCache_removeKeyTable(IfxCachedConnection *item, char *tablename);
+void ifxConnCache_resetKeyTables(IfxCachedConnection *item);
 
 #endif
@@ -22,16 +22,24 @@
 #include "access/htup_details.h"
 #endif
 
+#include "access/skey.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_aggregate.h"
 #include "catalog/pg_cast.h"
 #include "catalog/pg_namespace.h"
 #include "catalog/pg_operator.h"
+#include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
 #include "foreign/fdwapi.h"
 #include "foreign/foreign.h"
 #include "nodes/nodeFuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/var.h"
 #include "parser/parsetree.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/builtins.h"
+#include "utils/date.h"
+#include "utils/datetime.h"
 #include "utils/formatting.h"
 #include "utils/lsyscache.h"
 #include "utils/numeric.h"
@@ -41,6 +49,12 @@
 #endif
 
 #include "utils/syscache.h"
+#include "utils/timestamp.h"
+#include "utils/typcache.h"
+
+#if PG_VERSION_NUM >= 100000
+#include "utils/varlena.h"
+#endif
 
 #include "ifx_fdw.h"
 #include "ifx_node_utils.h"
@@ -58,6 +72,14 @@ deparse_predicate_node(IfxPushdownOprContext *context,
 
 static char *getIfxOperatorIdent(IfxPushdownOprInfo *pushdownInfo);
 
+static char *ifxDeparseScalarArrayOpExpr(ScalarArrayOpExpr *expr,
+										 char *operand, bool toplevel);
+static char *ifxDeparseKeySet(ScalarArrayOpExpr *expr, Var *operand,
+							  IfxPushdownOprContext *context);
+
+static char *ifxTemporalConstToLiteral(Const *const_val);
+static char *ifxDeparseConst(Const *const_val);
+
 #if PG_VERSION_NUM >= 90300
 static regproc getTypeOutputFunction(IfxFdwExecutionState *state,
 									 Oid inputOid);
@@ -1714,6 +1736,9 @@ static char *getIfxOperatorIdent(IfxPushdownOprInfo *pushdownInfo)
 		case IFX_OPR_LIKE:
 			result = "LIKE";
 			break;
+		case IFX_OPR_NOT_LIKE:
+			result = "NOT LIKE";
+			break;
 		default:
 			/* should not happen */
 			elog(ERROR, "could not deparse operator type %d",
@@ -1791,6 +1816,11 @@ IfxOprType mapPushdownOperator(Oid oprid, IfxPushdownOprInfo *pushdownInfo)
 		pushdownInfo->type = IFX_OPR_LIKE;
 		return IFX_OPR_LIKE;
 	}
+	else if (strcmp(oprname, "!~~") == 0)
+	{
+		pushdownInfo->type = IFX_OPR_NOT_LIKE;
+		return IFX_OPR_NOT_LIKE;
+	}
 	else
 	{
 		pushdownInfo->type = IFX_OPR_NOT_SUPPORTED;
@@ -1828,16 +1858,19 @@ static List *make_deparse_context(Oid foreignRelid)
 	(b)->predicates = lappend((b)->predicates, (a)); \
 	(b)->count++;
 
+/*
+ * NOTE: DATE, TIMESTAMP, TIME and INTERVAL constants are
+ *       deparsed into Informix literals by ifxTemporalConstToLiteral(),
+ *       see ifxConvertNodeConst(). We don't know how the Informix
+ *       server interprets values with time zones, so they are never
+ *       pushed down.
+ */
 static inline bool isCompatibleForPushdown(Oid typeOid)
 {
 	switch(typeOid)
 	{
-		case INTERVALOID:
-		case TIMESTAMPOID:
-		case TIMEOID:
 		case TIMESTAMPTZOID:
 		case TIMETZOID:
-		case DATEOID:
 			return false;
 	}
 
@@ -2035,6 +2068,22 @@ static Const *ifxConvertNodeConst(Const *oldNode, bool *converted,
 			*converted = true;
 			break;
 		}
+		case DATEOID:
+		case TIMESTAMPOID:
+		case TIMEOID:
+		case INTERVALOID:
+		{
+			/*
+			 * Temporal values are deparsed into Informix literals
+			 * by ifxDeparseConst(). Check wether the value can be
+			 * represented on the Informix side at all.
+			 */
+			if (ifxTemporalConstToLiteral(oldNode) == NULL)
+				*supported = false;
+
+			result = oldNode;
+			break;
+		}
 		default:
 			/* nothing to do */
 			result = oldNode;
@@ -2044,6 +2093,279 @@ static Const *ifxConvertNodeConst(Const *oldNode, bool *converted,
 	return result;
 }
 
+/*
+ * Splits the given number of microseconds into
+ * hours, minutes, seconds and microseconds.
+ */
+static void ifxSplitMicroseconds(int64 usecs, int *hour, int *min,
+								 int *sec, int *fusec)
+{
+	*hour  = (int) (usecs / INT64CONST(3600000000));
+	usecs -= (int64) *hour * INT64CONST(3600000000);
+	*min   = (int) (usecs / INT64CONST(60000000));
+	usecs -= (int64) *min * INT64CONST(60000000);
+	*sec   = (int) (usecs / INT64CONST(1000000));
+	*fusec = (int) (usecs - (int64) *sec * INT64CONST(1000000));
+}
+
+/*
+ * Returns the specified time value in microseconds.
+ */
+#if defined(HAVE_INT64_TIMESTAMP) || PG_VERSION_NUM >= 100000
+#define IFX_TIME_TO_USECS(t) ((int64) (t))
+#else
+#define IFX_TIME_TO_USECS(t) ((int64) rint((t) * 1000000.0))
+#endif
+
+/*
+ * ifxTemporalConstToLiteral()
+ *
+ * Renders a DATE, TIMESTAMP, TIME or INTERVAL constant into an
+ * Informix literal. The literals don't depend on any GL_DATE, GL_DATETIME
+ * or DBDATE settings:
+ *
+ * DATE      => MDY(month, day, year)
+ * TIMESTAMP => DATETIME(YYYY-MM-DD HH:MI:SS[.FFFFF]) YEAR TO SECOND|FRACTION(5)
+ * TIME      => DATETIME(HH:MI:SS[.FFFFF]) HOUR TO SECOND|FRACTION(5)
+ * INTERVAL  => INTERVAL(Y-MM) YEAR(9) TO MONTH or
+ *              INTERVAL(D HH:MI:SS.FFFFF) DAY(9) TO FRACTION(5)
+ *
+ * Returns NULL in case the value can't be represented by Informix
+ * exactly, e.g. infinite values, values with microsecond precision
+ * (Informix supports FRACTION(5) only) or intervals mixing months and
+ * days.
+ */
+static char *ifxTemporalConstToLiteral(Const *const_val)
+{
+	StringInfoData buf;
+
+	if (const_val->constisnull)
+		return "NULL";
+
+	initStringInfo(&buf);
+
+	switch (const_val->consttype)
+	{
+		case DATEOID:
+		{
+			DateADT date = DatumGetDateADT(const_val->constvalue);
+			int     year;
+			int     month;
+			int     day;
+
+			if (DATE_NOT_FINITE(date))
+				return NULL;
+
+			j2date(date + POSTGRES_EPOCH_JDATE, &year, &month, &day);
+
+			if ((year < 1) || (year > 9999))
+				return NULL;
+
+			appendStringInfo(&buf, "MDY(%d, %d, %d)", month, day, year);
+			break;
+		}
+		case TIMESTAMPOID:
+		{
+			Timestamp   ts = DatumGetTimestamp(const_val->constvalue);
+			struct pg_tm tm;
+			fsec_t      fsec;
+			int         fusec;
+
+			if (TIMESTAMP_NOT_FINITE(ts))
+				return NULL;
+
+			if (timestamp2tm(ts, NULL, &tm, &fsec, NULL, NULL) != 0)
+				return NULL;
+
+			if ((tm.tm_year < 1) || (tm.tm_year > 9999))
+				return NULL;
+
+			fusec = (int) IFX_TIME_TO_USECS(fsec);
+
+			if ((fusec % 10) != 0)
+				return NULL;
+
+			appendStringInfo(&buf, "DATETIME(%04d-%02d-%02d %02d:%02d:%02d",
+							 tm.tm_year, tm.tm_mon, tm.tm_mday,
+							 tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+			if (fusec > 0)
+				appendStringInfo(&buf, ".%05d) YEAR TO FRACTION(5)", fusec / 10);
+			else
+				appendStringInfoString(&buf, ") YEAR TO SECOND");
+			break;
+		}
+		case TIMEOID:
+		{
+			int hour;
+			int min;
+			int sec;
+			int fusec;
+
+			ifxSplitMicroseconds(IFX_TIME_TO_USECS(DatumGetTimeADT(const_val->constvalue)),
+								 &hour, &min, &sec, &fusec);
+
+			/* 24:00:00 isn't a valid Informix time */
+			if ((hour > 23) || ((fusec % 10) != 0))
+				return NULL;
+
+			appendStringInfo(&buf, "DATETIME(%02d:%02d:%02d", hour, min, sec);
+
+			if (fusec > 0)
+				appendStringInfo(&buf, ".%05d) HOUR TO FRACTION(5)", fusec / 10);
+			else
+				appendStringInfoString(&buf, ") HOUR TO SECOND");
+			break;
+		}
+		case INTERVALOID:
+		{
+			Interval *span = DatumGetIntervalP(const_val->constvalue);
+			int64     usecs;
+			int       days;
+			int       hour;
+			int       min;
+			int       sec;
+			int       fusec;
+
+			/*
+			 * Informix distinguishes between YEAR TO MONTH and
+			 * DAY TO FRACTION intervals, which can't be mixed. We
+			 * don't bother with negative intervals.
+			 */
+			if ((span->month < 0) || (span->day < 0) || (span->time < 0))
+				return NULL;
+
+			if (span->month > 0)
+			{
+				if ((span->day != 0) || (span->time != 0))
+					return NULL;
+
+				appendStringInfo(&buf, "INTERVAL(%d-%02d) YEAR(9) TO MONTH",
+								 span->month / MONTHS_PER_YEAR,
+								 span->month % MONTHS_PER_YEAR);
+				break;
+			}
+
+			/*
+			 * PostgreSQL compares intervals assuming days of
+			 * 24 hours, so it's safe to normalize the time part here.
+			 */
+			usecs = IFX_TIME_TO_USECS(span->time);
+			days  = span->day + (int) (usecs / INT64CONST(86400000000));
+			usecs = usecs % INT64CONST(86400000000);
+
+			ifxSplitMicroseconds(usecs, &hour, &min, &sec, &fusec);
+
+			if ((fusec % 10) != 0)
+				return NULL;
+
+			appendStringInfo(&buf, "INTERVAL(%d %02d:%02d:%02d.%05d) DAY(9) TO FRACTION(5)",
+							 days, hour, min, sec, fusec / 10);
+			break;
+		}
+		default:
+			return NULL;
+	}
+
+	return buf.data;
+}
+
+/*
+ * Deparses the specified constant value into a literal
+ * suitable to be passed to Informix.
+ */
+static char *ifxDeparseConst(Const *const_val)
+{
+	/* don't let deparse_expression() decorate NULL with a type cast */
+	if (const_val->constisnull)
+		return pstrdup("NULL");
+
+	switch (const_val->consttype)
+	{
+		case DATEOID:
+		case TIMESTAMPOID:
+		case TIMEOID:
+		case INTERVALOID:
+			return ifxTemporalConstToLiteral(const_val);
+		default:
+			return deparse_expression((Node *) const_val, NIL, false, false);
+	}
+}
+
+/*
+ * ifxIntervalOperandsMatch()
+ *
+ * Checks an operator expression combining an INTERVAL constant
+ * with an INTERVAL column. Informix can't mix YEAR TO MONTH and
+ * DAY TO FRACTION intervals, so the constant is only pushed down
+ * in case its class, as rendered by ifxTemporalConstToLiteral(), matches
+ * the qualifier of the remote column. Returns false if it doesn't or the
+ * qualifier can't be determined, true in all other cases.
+ */
+static bool ifxIntervalOperandsMatch(OpExpr *opr, List *relinfos)
+{
+	Node     *larg;
+	Node     *rarg;
+	Const    *const_val;
+	Var      *var;
+	ListCell *cell;
+	int       start;
+
+	if (list_length(opr->args) != 2)
+		return true;
+
+	larg = (Node *) linitial(opr->args);
+	rarg = (Node *) lsecond(opr->args);
+
+	if (IsA(larg, RelabelType))
+		larg = (Node *) ((RelabelType *) larg)->arg;
+	if (IsA(rarg, RelabelType))
+		rarg = (Node *) ((RelabelType *) rarg)->arg;
+
+	if (IsA(larg, Const) && (((Const *) larg)->consttype == INTERVALOID))
+	{
+		const_val = (Const *) larg;
+		larg      = rarg;
+	}
+	else if (IsA(rarg, Const) && (((Const *) rarg)->consttype == INTERVALOID))
+		const_val = (Const *) rarg;
+	else
+		return true;
+
+	/* e.g. DATETIME + INTERVAL, which works with both classes */
+	if (exprType(larg) != INTERVALOID)
+		return true;
+
+	if (const_val->constisnull)
+		return true;
+
+	if (!IsA(larg, Var))
+		return false;
+
+	var = (Var *) larg;
+
+	foreach(cell, relinfos)
+	{
+		IfxDeparseRelInfo *relinfo = (IfxDeparseRelInfo *) lfirst(cell);
+
+		if (relinfo->rtid != var->varno)
+			continue;
+
+		start = ifxGetRemoteIntervalStart(relinfo->foreignRelid, var->varattno);
+
+		if (start < 0)
+			return false;
+
+		/* see ifxTemporalConstToLiteral() */
+		if (DatumGetIntervalP(const_val->constvalue)->month > 0)
+			return (start <= IFX_TU_MONTH);
+		else
+			return (start > IFX_TU_MONTH);
+	}
+
+	return false;
+}
+
 /*
  * Handle a cooked or deparse expression according
  * to the current state of the specified IfxPushdownOprInfo
@@ -2068,6 +2390,194 @@ static void ifxCookExpr(IfxPushdownOprInfo *info,
 	}
 }
 
+/*
+ * Deparses a ScalarArrayOpExpr with a constant array into an
+ * Informix IN (...) list, operand being the already deparsed left
+ * operand of the expression. Returns NULL in case the expression
+ * can't be pushed down.
+ *
+ * We support
+ *
+ * operand = ANY(ARRAY[...]), e.g. from an IN (...) list, and
+ * operand <> ALL(ARRAY[...]), e.g. from a NOT IN (...) list.
+ *
+ * Large arrays are split into IN lists of at most IFX_IN_LIST_CHUNK_SIZE
+ * elements, combined with OR (or AND for NOT IN), to stay within
+ * the statement limits of the Informix server. Arrays with more than
+ * IFX_IN_LIST_MAX_ELEMS elements aren't pushed down at all.
+ *
+ * toplevel tells wether the expression is a top-level qual of the
+ * WHERE clause, see the handling of NULL elements below.
+ */
+static char *ifxDeparseScalarArrayOpExpr(ScalarArrayOpExpr *expr,
+										 char *operand, bool toplevel)
+{
+	IfxPushdownOprInfo  info;
+	Const              *array_const;
+	ArrayType          *array;
+	Oid                 elemtype;
+	int16               elemlen;
+	bool                elembyval;
+	char                elemalign;
+	Datum              *elems;
+	bool               *elemnulls;
+	int                 nelems;
+	int                 nlists;
+	int                 nemitted;
+	int                 i;
+	bool                is_in;
+	StringInfoData      buf;
+
+	if ((operand == NULL)
+		|| (list_length(expr->args) != 2)
+		|| !IsA(lsecond(expr->args), Const))
+		return NULL;
+
+	/*
+	 * Check for = ANY(...) or <> ALL(...)
+	 */
+	switch (mapPushdownOperator(expr->opno, &info))
+	{
+		case IFX_OPR_EQUAL:
+			if (!expr->useOr)
+				return NULL;
+			is_in = true;
+			break;
+		case IFX_OPR_NEQUAL:
+			if (expr->useOr)
+				return NULL;
+			is_in = false;
+			break;
+		default:
+			return NULL;
+	}
+
+	array_const = (Const *) lsecond(expr->args);
+
+	if (array_const->constisnull)
+		return NULL;
+
+	array    = DatumGetArrayTypeP(array_const->constvalue);
+	elemtype = ARR_ELEMTYPE(array);
+
+	/*
+	 * We don't know the remote column here, so INTERVAL lists can't
+	 * be checked against its qualifier (see ifxIntervalOperandsMatch()).
+	 */
+	if (!isCompatibleForPushdown(elemtype)
+		|| (elemtype == INTERVALOID))
+		return NULL;
+
+	get_typlenbyvalalign(elemtype, &elemlen, &elembyval, &elemalign);
+	deconstruct_array(array, elemtype, elemlen, elembyval, elemalign,
+					  &elems, &elemnulls, &nelems);
+
+	/*
+	 * An empty list doesn't make sense to be pushed down, neither
+	 * do we bother with too large lists.
+	 */
+	if ((nelems == 0) || (nelems > IFX_IN_LIST_MAX_ELEMS))
+		return NULL;
+
+	initStringInfo(&buf);
+	nlists   = 0;
+	nemitted = 0;
+
+	for (i = 0; i < nelems; i++)
+	{
+		Const *elem_const;
+		Const *converted_const;
+		bool   converted = false;
+		bool   supported = true;
+
+		/*
+		 * A NULL element never lets NOT IN evaluate to true. It
+		 * turns false into NULL for an IN list, which only doesn't
+		 * matter for a top-level qual, so we drop it there. Elsewhere,
+		 * e.g. below NOT or within a CASE expression, the result
+		 * would change.
+		 */
+		if (elemnulls[i])
+		{
+			if (!is_in || !toplevel)
+				return NULL;
+
+			continue;
+		}
+
+		elem_const = makeConst(elemtype, -1, array_const->constcollid,
+							   elemlen, elems[i], false, elembyval);
+		converted_const = ifxConvertNodeConst(elem_const, &converted,
+											  &supported);
+
+		if (!supported)
+			return NULL;
+
+		/*
+		 * Start a new list, if required.
+		 */
+		if ((nemitted % IFX_IN_LIST_CHUNK_SIZE) == 0)
+		{
+			if (nlists > 0)
+				appendStringInfo(&buf, ") %s ", is_in ? "OR" : "AND");
+
+			appendStringInfo(&buf, "%s %sIN (", operand, is_in ? "" : "NOT ");
+			nlists++;
+		}
+		else
+			appendStringInfoString(&buf, ", ");
+
+		appendStringInfoString(&buf, ifxDeparseConst(converted_const));
+		nemitted++;
+	}
+
+	/* only NULL elements */
+	if (nlists == 0)
+		return NULL;
+
+	appendStringInfoChar(&buf, ')');
+
+	if (nlists > 1)
+	{
+		StringInfoData result;
+
+		initStringInfo(&result);
+		appendStringInfo(&result, "(%s)", buf.data);
+		return result.data;
+	}
+
+	return buf.data;
+}
+
+/*
+ * Returns true in case the given operator expression
+ * compares a column with a constant value.
+ */
+static bool isVarOpConstExpr(OpExpr *opr)
+{
+	ListCell *cell;
+	int       nvars   = 0;
+	int       nconsts = 0;
+
+	if (list_length(opr->args) != 2)
+		return false;
+
+	foreach(cell, opr->args)
+	{
+		Node *arg = (Node *) lfirst(cell);
+
+		if (IsA(arg, RelabelType)
+			&& IsA(((RelabelType *) arg)->arg, Var))
+			nvars++;
+		else if (IsA(arg, Var))
+			nvars++;
+		else if (IsA(arg, Const))
+			nconsts++;
+	}
+
+	return ((nvars == 1) && (nconsts == 1));
+}
+
 /*
  * ifx_predicate_tree_walker()
  *
@@ -2079,7 +2589,10 @@ static void ifxCookExpr(IfxPushdownOprInfo *info,
  * FDW col >(=) CONST
  * FDW col <(=) CONST
  *
- * Only CONST and VAR expressions are currently supported.
+ * These are cooked below, other operator expressions are deparsed
+ * by ifxDeparseRemoteExpr() (see isVarOpConstExpr()). Supported
+ * expressions can be combined with AND, OR and NOT, see the handling
+ * of BoolExpr below.
  */
 bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context)
 {
@@ -2094,95 +2607,200 @@ bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context
 	/*
 	 * Handle BoolExpr. Recurse into its arguments
 	 * and try to decode its OpExpr accordingly.
+	 *
+	 * A boolean expression is pushed down as a whole or not
+	 * at all: pushing down only some arguments of an OR or NOT
+	 * expression would return wrong results. Thus each argument is
+	 * examined within its own context and must result in exactly one
+	 * pushdown predicate. The deparsed arguments are then combined into
+	 * a single, parenthesized IfxPushdownOprInfo recorded in our
+	 * context.
 	 */
 	if (IsA(node, BoolExpr))
 	{
-		BoolExpr *boolexpr;
-		ListCell *cell;
+		BoolExpr       *boolexpr;
+		ListCell       *cell;
+		StringInfoData  buf;
+		char           *oprstr = NULL;
 
 		boolexpr = (BoolExpr *) node;
 
+		info = palloc(sizeof(IfxPushdownOprInfo));
+		info->expr        = (Expr *) node;
+		info->num_args    = list_length(boolexpr->args);
+		info->arg_idx     = 0;
+		info->deparsetype = IFX_DEPARSED_EXPR;
+
+		switch (boolexpr->boolop)
+		{
+			case AND_EXPR:
+				info->type = IFX_OPR_AND;
+				oprstr     = "AND";
+				break;
+			case OR_EXPR:
+				info->type = IFX_OPR_OR;
+				oprstr     = "OR";
+				context->has_or_expr = true;
+				break;
+			case NOT_EXPR:
+				info->type = IFX_OPR_NOT;
+				oprstr     = "NOT";
+				break;
+			default:
+				elog(ERROR, "unsupported boolean expression type");
+		}
+
+		initStringInfo(&buf);
+		appendStringInfoChar(&buf, '(');
+
+		if (info->type == IFX_OPR_NOT)
+			appendStringInfo(&buf, "%s ", oprstr);
+
 		/*
 		 * Decode the arguments to the BoolExpr
 		 * directly, don't leave it to expression_tree_walker()
-		 *
-		 * By going down this route, we are able to push the
-		 * IfxPushdownOprInfo into our context list in the right
-		 * order.
 		 */
 		foreach(cell, boolexpr->args)
 		{
-			Node *bool_arg = (Node *) lfirst(cell);
-
-			ifx_predicate_tree_walker(bool_arg, context);
+			Node                  *bool_arg = (Node *) lfirst(cell);
+			IfxPushdownOprContext  arg_context;
+			IfxPushdownOprInfo    *arg_info;
+
+			arg_context.foreign_relid = context->foreign_relid;
+			arg_context.foreign_rtid  = context->foreign_rtid;
+			arg_context.predicates    = NIL;
+			arg_context.count         = 0;
+			arg_context.count_removed = 0;
+			arg_context.has_or_expr   = false;
+			arg_context.shippable_funcs = context->shippable_funcs;
+			arg_context.allow_params    = context->allow_params;
+			arg_context.params          = NIL;
+			arg_context.allow_key_sets  = context->allow_key_sets;
+			arg_context.key_sets        = NIL;
+			arg_context.key_set_base    = context->key_set_base
+				+ list_length(context->key_sets);
+			arg_context.key_set_refid   = context->key_set_refid;
+			arg_context.toplevel        = false;
+
+			ifx_predicate_tree_walker(bool_arg, &arg_context);
 
 			/*
-			 * End of arguments?
-			 * If true, don't add additional pushdown info
+			 * Argument not (completely) supported, so
+			 * we can't push down this expression at all.
 			 */
-			if (lnext(cell) != NULL)
+			if ((arg_context.count != 1)
+				|| (arg_context.count_removed > 0))
 			{
-				/*
-				 * Save boolean expression type.
-				 */
-				info = palloc(sizeof(IfxPushdownOprInfo));
-				info->expr        = NULL;
-				info->num_args    = 0;
-				info->arg_idx     = 0;
-				info->deparsetype = IFX_DEPARSED_EXPR;
+				context->count_removed++;
+				return true;
+			}
 
-				switch (boolexpr->boolop)
-				{
-					case AND_EXPR:
-						info->type        = IFX_OPR_AND;
-						info->expr_string = cstring_to_text("AND");
-						break;
-					case OR_EXPR:
-						info->type        = IFX_OPR_OR;
-						info->expr_string = cstring_to_text("OR");
-						context->has_or_expr = true;
-						break;
-					case NOT_EXPR:
-						info->type        = IFX_OPR_NOT;
-						info->expr_string = cstring_to_text("NOT");
-						break;
-					default:
-						elog(ERROR, "unsupported boolean expression type");
-				}
+			arg_info = (IfxPushdownOprInfo *) linitial(arg_context.predicates);
 
-				/* Push to the predicates list, but don't mark it
-				 * as a pushdown expression */
-				IFX_MARK_PREDICATE_BOOL(info, context);
-			}
+			/* placeholders are bound in the order of the arguments */
+			context->params   = list_concat(context->params, arg_context.params);
+			context->key_sets = list_concat(context->key_sets, arg_context.key_sets);
+
+			if (cell != list_head(boolexpr->args))
+				appendStringInfo(&buf, " %s ", oprstr);
+
+			appendStringInfoString(&buf, text_to_cstring(arg_info->expr_string));
+			info->arg_idx++;
 		}
 
+		appendStringInfoChar(&buf, ')');
+		info->expr_string = cstring_to_text(buf.data);
+
+		/* Mark this expression for pushdown */
+		IFX_MARK_PREDICATE_BOOL(info, context);
+
+		elog(DEBUG1, "deparsed pushdown predicate %d, %s",
+			 context->count - 1, buf.data);
+
 		/* done */
 		return true;
 	}
 
 	/*
-	 * Check for <var> IS NULL or <var> IS NOT NULL
+	 * Check for <var> IN (...) or <var> NOT IN (...), given
+	 * as a ScalarArrayOpExpr with a constant array. Large or
+	 * parameterized arrays might be shipped via a key table.
 	 */
-	else if (IsA(node, NullTest))
+	else if (IsA(node, ScalarArrayOpExpr))
 	{
-		NullTest *ntest;
-		bool      operand_supported;
+		ScalarArrayOpExpr *saop = (ScalarArrayOpExpr *) node;
+		Node              *operand;
+		char              *deparsed = NULL;
 
-		ntest = (NullTest *)node;
-		info = palloc(sizeof(IfxPushdownOprInfo));
-		info->expr = (Expr *)node;
-		info->expr_string = NULL;
-		info->deparsetype = IFX_DEPARSED_EXPR;
-		info->num_args    = 1;
-		info->arg_idx     = 0;
+		operand = (Node *) linitial(saop->args);
 
-		/*
-		 * NullTest on composite types can be thrown away immediately.
-		 */
-		if (ntest->argisrow)
-			return true;
+		/* see T_RelabelType handling of OpExpr below */
+		if (IsA(operand, RelabelType))
+			operand = (Node *) ((RelabelType *) operand)->arg;
 
-		/*
+		if (IsA(operand, Var)
+			&& (((Var *) operand)->varno == context->foreign_rtid)
+			&& (((Var *) operand)->varlevelsup == 0)
+			&& (((Var *) operand)->varattno > 0))
+		{
+			if (context->allow_key_sets)
+				deparsed = ifxDeparseKeySet(saop, (Var *) operand, context);
+
+			if (deparsed == NULL)
+				deparsed = ifxDeparseScalarArrayOpExpr(saop,
+													   ifxGetRemoteColumnName(context->foreign_relid,
+																			  ((Var *) operand)->varattno),
+													   context->toplevel);
+		}
+
+		if (deparsed == NULL)
+		{
+			context->count_removed++;
+			return true;
+		}
+
+		info = palloc(sizeof(IfxPushdownOprInfo));
+		info->type        = IFX_OPR_IN;
+		info->expr        = (Expr *) node;
+		info->deparsetype = IFX_DEPARSED_EXPR;
+		info->num_args    = 2;
+		info->arg_idx     = 2;
+		info->expr_string = cstring_to_text(deparsed);
+
+		/*
+		 * Mark this expression for pushdown.
+		 */
+		IFX_MARK_PREDICATE_ELEM(info, context);
+
+		elog(DEBUG1, "deparsed pushdown predicate %d, %s",
+			 context->count - 1, deparsed);
+
+		return true;
+	}
+
+	/*
+	 * Check for <var> IS NULL or <var> IS NOT NULL
+	 */
+	else if (IsA(node, NullTest))
+	{
+		NullTest *ntest;
+		bool      operand_supported;
+
+		ntest = (NullTest *)node;
+		info = palloc(sizeof(IfxPushdownOprInfo));
+		info->expr = (Expr *)node;
+		info->expr_string = NULL;
+		info->deparsetype = IFX_DEPARSED_EXPR;
+		info->num_args    = 1;
+		info->arg_idx     = 0;
+
+		/*
+		 * NullTest on composite types can be thrown away immediately.
+		 */
+		if (ntest->argisrow)
+			return true;
+
+		/*
 		 * [NOT] NULL ...
 		 */
 		switch (ntest->nulltesttype)
@@ -2259,6 +2877,57 @@ bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context
 		info->arg_idx     = 0;
 		info->expr_string = NULL;
 
+		/*
+		 * Anything else than comparing a column with a constant
+		 * (e.g. comparing two columns, arithmetic, function calls or
+		 * CASE expressions) is beyond what the cooking machinery below
+		 * can handle. Deparse the whole expression with
+		 * ifxDeparseRemoteExpr() instead, which knows about operators
+		 * and functions shippable to Informix.
+		 */
+		if (!isVarOpConstExpr(opr))
+		{
+			IfxDeparseRelInfo  relinfo;
+			char              *deparsed;
+
+			relinfo.rtid            = context->foreign_rtid;
+			relinfo.foreignRelid    = context->foreign_relid;
+			relinfo.alias           = NULL;
+			relinfo.shippable_funcs = context->shippable_funcs;
+
+			if (mapPushdownOperator(opr->opno, info) == IFX_OPR_NOT_SUPPORTED)
+			{
+				context->count_removed++;
+				return true;
+			}
+
+			/*
+			 * NOTE: Placeholders of a predicate not pushed down are
+			 *       discarded by ifxFilterQuals().
+			 */
+			deparsed = ifxDeparseRemoteExpr(node, list_make1(&relinfo),
+											context->allow_params ? &context->params : NULL);
+
+			if (deparsed == NULL)
+			{
+				context->count_removed++;
+				return true;
+			}
+
+			info->arg_idx     = info->num_args;
+			info->expr_string = cstring_to_text(deparsed);
+
+			/*
+			 * Mark this predicate for pushdown.
+			 */
+			IFX_MARK_PREDICATE_ELEM(info, context);
+
+			elog(DEBUG1, "deparsed pushdown predicate %d, %s",
+				 context->count - 1, deparsed);
+
+			return true;
+		}
+
 		if (mapPushdownOperator(opr->opno, info) != IFX_OPR_NOT_SUPPORTED)
 		{
 			ListCell *cell;
@@ -2383,6 +3052,18 @@ bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context
 				}
 			}
 
+			if (operand_supported)
+			{
+				IfxDeparseRelInfo relinfo;
+
+				relinfo.rtid            = context->foreign_rtid;
+				relinfo.foreignRelid    = context->foreign_relid;
+				relinfo.alias           = NULL;
+				relinfo.shippable_funcs = context->shippable_funcs;
+
+				operand_supported = ifxIntervalOperandsMatch(opr, list_make1(&relinfo));
+			}
+
 			/*
 			 * If any operand not supported is found, don't
 			 * bother adding this operator expression to the pushdown
@@ -2416,6 +3097,26 @@ bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context
 	return false;
 }
 
+/*
+ * Deparse a single operand of a predicate. Columns are
+ * deparsed into the remote column identifier, see
+ * ifxGetRemoteColumnName().
+ */
+static char *
+deparse_predicate_operand(IfxPushdownOprContext *context,
+						  Node *operand,
+						  List *dpc)
+{
+	if (IsA(operand, Const))
+		return ifxDeparseConst((Const *) operand);
+
+	if (IsA(operand, Var) && ((Var *) operand)->varattno > 0)
+		return ifxGetRemoteColumnName(context->foreign_relid,
+									  ((Var *) operand)->varattno);
+
+	return deparse_expression(operand, dpc, false, false);
+}
+
 /*
  * Deparse the given Node into a string assigned
  * to the specified IfxPushdownOprInfo pointer.
@@ -2470,7 +3171,18 @@ deparse_predicate_node(IfxPushdownOprContext *context,
 	 */
 	if (info->num_args == 1)
 	{
-		appendStringInfoString(&predstr, deparse_expression(copy_obj, dpc, false, false));
+		NullTest *ntest = (NullTest *) copy_obj;
+
+		/*
+		 * Deparse the column identifier of a NullTest ourselves,
+		 * since it might be mapped to a different remote column.
+		 */
+		if (IsA(copy_obj, NullTest) && IsA(ntest->arg, Var))
+			appendStringInfo(&predstr, "%s %s",
+							 deparse_predicate_operand(context, (Node *) ntest->arg, dpc),
+							 (ntest->nulltesttype == IS_NULL) ? "IS NULL" : "IS NOT NULL");
+		else
+			appendStringInfoString(&predstr, deparse_expression(copy_obj, dpc, false, false));
 	}
 	else if (info->num_args > 1)
 	{
@@ -2490,9 +3202,9 @@ deparse_predicate_node(IfxPushdownOprContext *context,
 		oprarg_right = (Node *)lsecond(((OpExpr *)info->expr)->args);
 
 		appendStringInfo(&predstr, "%s %s %s",
-						 deparse_expression(oprarg_left, dpc, false, false),
+						 deparse_predicate_operand(context, oprarg_left, dpc),
 						 oprstr,
-						 deparse_expression(oprarg_right, dpc, false, false));
+						 deparse_predicate_operand(context, oprarg_right, dpc));
 	}
 
 	info->expr_string = cstring_to_text(predstr.data);
@@ -2500,3 +3212,1634 @@ deparse_predicate_node(IfxPushdownOprContext *context,
 		 context->count - 1,
 		 text_to_cstring(info->expr_string));
 }
+
+#if PG_VERSION_NUM >= 90200
+
+/*
+ * Returns true if the sort order of the specified
+ * type is known to be the same on PostgreSQL and Informix.
+ *
+ * NOTE: We don't consider any character types here, since
+ *       their sort order depends on the locale and collation
+ *       settings on both sides.
+ */
+static inline bool isCompatibleForSort(Oid typeOid)
+{
+	switch(typeOid)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case FLOAT4OID:
+		case FLOAT8OID:
+		case NUMERICOID:
+		case BOOLOID:
+		case DATEOID:
+		case TIMESTAMPOID:
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Returns true if values of the specified type are known to
+ * compare equal on PostgreSQL and Informix alike, e.g. when
+ * eliminating duplicates with DISTINCT.
+ *
+ * NOTE: Character types aren't considered for the same reasons
+ *       as in isCompatibleForSort(). Floating point types are
+ *       excluded as well, since Informix doesn't treat NaN values
+ *       as equal.
+ */
+bool ifxIsCompatibleForEquality(Oid typeOid)
+{
+	switch(typeOid)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case NUMERICOID:
+		case BOOLOID:
+		case DATEOID:
+		case TIMESTAMPOID:
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Returns the member expression of the given equivalence
+ * class which belongs to the specified relation, NULL in case
+ * there is none.
+ */
+static Expr *ifxFindEMExprForRel(EquivalenceClass *ec, RelOptInfo *baserel)
+{
+	ListCell *cell;
+
+	foreach(cell, ec->ec_members)
+	{
+		EquivalenceMember *em = (EquivalenceMember *) lfirst(cell);
+
+		if (bms_equal(em->em_relids, baserel->relids))
+			return em->em_expr;
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns true if the specified column of the foreign
+ * table is declared NOT NULL.
+ */
+static bool ifxAttrIsNotNull(Oid foreignRelid, AttrNumber attnum)
+{
+	HeapTuple         tuple;
+	bool              result;
+
+	tuple = SearchSysCache2(ATTNUM,
+							ObjectIdGetDatum(foreignRelid),
+							Int16GetDatum(attnum));
+
+	if (!HeapTupleIsValid(tuple))
+		elog(ERROR, "cache lookup failed for attribute %d of relation %u",
+			 attnum, foreignRelid);
+
+	result = ((Form_pg_attribute) GETSTRUCT(tuple))->attnotnull;
+	ReleaseSysCache(tuple);
+
+	return result;
+}
+
+/*
+ * ifxDeparsePathkeys()
+ *
+ * Deparses the given list of pathkeys into a column list suitable
+ * to be passed to the ORDER BY clause of the remote query. Returns NULL
+ * in case any of the pathkeys can't be evaluated on the Informix server
+ * with the same sort order than PostgreSQL would do.
+ *
+ * We currently support plain column references only. Informix
+ * sorts NULL values first in ascending order and last in descending
+ * order by default, which is just the other way round than PostgreSQL
+ * does. For nullable columns, NULLS FIRST or NULLS LAST is added in
+ * case nulls_ordering is true (Informix 12.10 and above), otherwise
+ * pathkeys requesting a different NULL ordering are only accepted for
+ * columns declared NOT NULL locally.
+ */
+char *ifxDeparsePathkeys(RelOptInfo *baserel, Oid foreignRelid,
+						 List *pathkeys, bool nulls_ordering)
+{
+	StringInfoData  buf;
+	ListCell       *cell;
+
+	if (pathkeys == NIL)
+		return NULL;
+
+	initStringInfo(&buf);
+
+	foreach(cell, pathkeys)
+	{
+		PathKey        *pathkey = (PathKey *) lfirst(cell);
+		Expr           *em_expr;
+		Var            *var;
+		TypeCacheEntry *typentry;
+		bool            ifx_nulls_first;
+		char           *nulls = "";
+
+		if (pathkey->pk_eclass->ec_has_volatile)
+			return NULL;
+
+		em_expr = ifxFindEMExprForRel(pathkey->pk_eclass, baserel);
+
+		if ((em_expr == NULL) || !IsA(em_expr, Var))
+			return NULL;
+
+		var = (Var *) em_expr;
+
+		if ((var->varno != baserel->relid)
+			|| (var->varlevelsup != 0)
+			|| (var->varattno <= 0))
+			return NULL;
+
+		if (!isCompatibleForSort(var->vartype))
+			return NULL;
+
+		/*
+		 * The pathkey must use the default btree
+		 * operator family of the column datatype, otherwise
+		 * the remote sort order can't be the same.
+		 */
+		typentry = lookup_type_cache(var->vartype, TYPECACHE_BTREE_OPFAMILY);
+
+		if (typentry->btree_opf != pathkey->pk_opfamily)
+			return NULL;
+
+		ifx_nulls_first = (pathkey->pk_strategy == BTLessStrategyNumber);
+
+		if ((pathkey->pk_nulls_first != ifx_nulls_first)
+			&& !ifxAttrIsNotNull(foreignRelid, var->varattno))
+		{
+			if (!nulls_ordering)
+				return NULL;
+
+			nulls = (pathkey->pk_nulls_first) ? " NULLS FIRST" : " NULLS LAST";
+		}
+
+		appendStringInfo(&buf, "%s%s %s%s",
+						 (cell == list_head(pathkeys)) ? "" : ", ",
+						 ifxGetRemoteColumnName(foreignRelid, var->varattno),
+						 (pathkey->pk_strategy == BTLessStrategyNumber) ? "ASC" : "DESC",
+						 nulls);
+	}
+
+	elog(DEBUG2, "deparsed pathkeys for pushdown: %s", buf.data);
+
+	return buf.data;
+}
+
+#endif
+
+#if PG_VERSION_NUM >= 90500
+
+/*
+ * Deparses the specified aggregate into an Informix
+ * aggregate expression, NULL in case the aggregate can't be evaluated
+ * remotely.
+ *
+ * We support the builtin aggregates COUNT(), SUM(), AVG(), MIN() and
+ * MAX() only. Since we have to match the result type expected by
+ * PostgreSQL, the remote result is casted accordingly.
+ */
+static char *ifxDeparseAggref(Aggref *aggref, List *relinfos, List **params)
+{
+	char *aggname;
+	char *cast = "";
+	char *arg;
+	Expr *argexpr;
+	Oid   argtype;
+
+	/*
+	 * No DISTINCT, ORDER BY or FILTER, and we don't bother with
+	 * partial or ordered-set aggregation.
+	 */
+	if ((aggref->aggdistinct != NIL)
+		|| (aggref->aggorder != NIL)
+		|| (aggref->aggfilter != NULL)
+		|| aggref->aggvariadic
+		|| (aggref->agglevelsup > 0)
+		|| (aggref->aggkind != AGGKIND_NORMAL))
+		return NULL;
+
+#if PG_VERSION_NUM >= 90600
+	if (aggref->aggsplit != AGGSPLIT_SIMPLE)
+		return NULL;
+#endif
+
+	if (get_func_namespace(aggref->aggfnoid) != PG_CATALOG_NAMESPACE)
+		return NULL;
+
+	aggname = get_func_name(aggref->aggfnoid);
+
+	if (aggname == NULL)
+		return NULL;
+
+	/*
+	 * COUNT(*)
+	 */
+	if (aggref->aggstar)
+	{
+		if (strcmp(aggname, "count") != 0)
+			return NULL;
+
+		return pstrdup("COUNT(*)::BIGINT");
+	}
+
+	if (list_length(aggref->args) != 1)
+		return NULL;
+
+	argexpr = ((TargetEntry *) linitial(aggref->args))->expr;
+	argtype = exprType((Node *) argexpr);
+
+	if (strcmp(aggname, "count") == 0)
+	{
+		cast = "::BIGINT";
+	}
+	else if ((strcmp(aggname, "sum") == 0)
+			 || (strcmp(aggname, "avg") == 0))
+	{
+		switch(argtype)
+		{
+			case INT2OID:
+			case INT4OID:
+				cast = (strcmp(aggname, "sum") == 0) ? "::BIGINT" : "::DECIMAL(32)";
+				break;
+			case INT8OID:
+			case NUMERICOID:
+				cast = "::DECIMAL(32)";
+				break;
+			default:
+				/* we can't convert other result types */
+				return NULL;
+		}
+	}
+	else if ((strcmp(aggname, "min") == 0)
+			 || (strcmp(aggname, "max") == 0))
+	{
+		/*
+		 * The result must be the same on both sides, so we
+		 * apply the same restrictions as for sorted output. We
+		 * can't convert floating point values from Informix.
+		 */
+		if (!isCompatibleForSort(argtype)
+			|| (argtype == FLOAT4OID)
+			|| (argtype == FLOAT8OID))
+			return NULL;
+	}
+	else
+	{
+		/* not supported */
+		return NULL;
+	}
+
+	arg = ifxDeparseRemoteExpr((Node *) argexpr, relinfos, params);
+
+	if (arg == NULL)
+		return NULL;
+
+	return psprintf("%s(%s)%s", asc_toupper(aggname, strlen(aggname)), arg, cast);
+}
+
+#endif
+
+/*
+ * Kind of arguments accepted by a shippable function.
+ */
+typedef enum IfxShippableArgType
+{
+	IFX_FUNC_ARG_STRING,   /* first argument is a string, others integers */
+	IFX_FUNC_ARG_VARLEN,   /* text or varchar argument, but not bpchar */
+	IFX_FUNC_ARG_SUBSTR,   /* string, positive constant start, length */
+	IFX_FUNC_ARG_NUMERIC,  /* numeric arguments */
+	IFX_FUNC_ARG_DATE_PART /* date_part(field, timestamp) */
+} IfxShippableArgType;
+
+/*
+ * Describes a builtin PostgreSQL function which can be
+ * evaluated by Informix.
+ */
+typedef struct IfxShippableFunction
+{
+	char                *pgname;  /* name of the function in pg_catalog */
+	int                  nargs;   /* number of arguments */
+	char                *ifxname; /* Informix equivalent */
+	IfxShippableArgType  argtype; /* kind of arguments */
+} IfxShippableFunction;
+
+/*
+ * Registry of builtin functions with an Informix equivalent.
+ *
+ * NOTE: length() counts characters in PostgreSQL, whereas Informix
+ *       LENGTH() counts bytes without trailing blanks, so map it
+ *       to CHAR_LENGTH(). This is only correct for text and varchar,
+ *       PostgreSQL ignores the trailing blanks of a bpchar but
+ *       CHAR_LENGTH() doesn't, so length() of a bpchar isn't shipped.
+ *
+ * NOTE: substr() starting at zero or a negative position
+ *       behaves differently in Informix, so substr() is only shipped
+ *       with a positive constant start position.
+ */
+static IfxShippableFunction ifxShippableFunctions[] =
+{
+	{ "lower",            1, "LOWER",        IFX_FUNC_ARG_STRING },
+	{ "upper",            1, "UPPER",        IFX_FUNC_ARG_STRING },
+	{ "btrim",            1, "TRIM",         IFX_FUNC_ARG_STRING },
+	{ "ltrim",            1, "LTRIM",        IFX_FUNC_ARG_STRING },
+	{ "rtrim",            1, "RTRIM",        IFX_FUNC_ARG_STRING },
+	{ "substr",           2, "SUBSTR",       IFX_FUNC_ARG_SUBSTR },
+	{ "substr",           3, "SUBSTR",       IFX_FUNC_ARG_SUBSTR },
+	{ "substring",        2, "SUBSTR",       IFX_FUNC_ARG_SUBSTR },
+	{ "substring",        3, "SUBSTR",       IFX_FUNC_ARG_SUBSTR },
+	{ "length",           1, "CHAR_LENGTH",  IFX_FUNC_ARG_VARLEN },
+	{ "char_length",      1, "CHAR_LENGTH",  IFX_FUNC_ARG_VARLEN },
+	{ "character_length", 1, "CHAR_LENGTH",  IFX_FUNC_ARG_VARLEN },
+	{ "octet_length",     1, "OCTET_LENGTH", IFX_FUNC_ARG_STRING },
+	{ "abs",              1, "ABS",          IFX_FUNC_ARG_NUMERIC },
+	{ "mod",              2, "MOD",          IFX_FUNC_ARG_NUMERIC },
+	{ "date_part",        2, NULL,           IFX_FUNC_ARG_DATE_PART },
+	{ NULL,               0, NULL,           IFX_FUNC_ARG_STRING }
+};
+
+/*
+ * Fields of date_part() supported by Informix and their
+ * equivalent functions.
+ */
+static char *ifxDatePartFunctions[][2] =
+{
+	{ "year",  "YEAR" },
+	{ "month", "MONTH" },
+	{ "day",   "DAY" },
+	{ "dow",   "WEEKDAY" },
+	{ NULL,    NULL }
+};
+
+static inline bool isStringType(Oid typeOid)
+{
+	return ((typeOid == TEXTOID)
+			|| (typeOid == VARCHAROID)
+			|| (typeOid == BPCHAROID));
+}
+
+static inline bool isNumericType(Oid typeOid)
+{
+	switch (typeOid)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case NUMERICOID:
+		case FLOAT4OID:
+		case FLOAT8OID:
+			return true;
+	}
+
+	return false;
+}
+
+static inline bool isIntegerType(Oid typeOid)
+{
+	return ((typeOid == INT2OID)
+			|| (typeOid == INT4OID)
+			|| (typeOid == INT8OID));
+}
+
+/*
+ * ifxParseShippableFunctions()
+ *
+ * Parses the value of the pushdown_functions option, a comma separated
+ * list of function names, into a list of names. Returns NIL in case
+ * of a malformed list.
+ */
+List *ifxParseShippableFunctions(char *value)
+{
+	List *names = NIL;
+
+	if (value == NULL)
+		return NIL;
+
+	if (!SplitIdentifierString(pstrdup(value), ',', &names))
+		return NIL;
+
+	return names;
+}
+
+/*
+ * Returns true in case the given function was declared shippable
+ * by the pushdown_functions option of any of the specified foreign tables.
+ */
+static bool ifxIsUserShippableFunction(Oid funcid, char *funcname,
+									   List *relinfos)
+{
+	ListCell *cell;
+
+	/*
+	 * The result must only depend on the arguments, otherwise
+	 * we can't evaluate it on the remote server.
+	 */
+	if (func_volatile(funcid) != PROVOLATILE_IMMUTABLE)
+		return false;
+
+	foreach(cell, relinfos)
+	{
+		IfxDeparseRelInfo *relinfo = (IfxDeparseRelInfo *) lfirst(cell);
+		ListCell          *name_cell;
+
+		foreach(name_cell, relinfo->shippable_funcs)
+		{
+			if (strcmp((char *) lfirst(name_cell), funcname) == 0)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Deparses a list of function arguments into the given buffer,
+ * separated by commas. Returns false if any argument can't
+ * be deparsed.
+ */
+static bool ifxDeparseFuncArgs(StringInfo buf, List *args, List *relinfos,
+							   List **params)
+{
+	ListCell *cell;
+
+	foreach(cell, args)
+	{
+		char *arg = ifxDeparseRemoteExpr((Node *) lfirst(cell), relinfos, params);
+
+		if (arg == NULL)
+			return false;
+
+		appendStringInfo(buf, "%s%s",
+						 (cell == list_head(args)) ? "" : ", ",
+						 arg);
+	}
+
+	return true;
+}
+
+/*
+ * Deparses a cast between the specified types.
+ *
+ * We support casts which can't change the value only, that
+ * is widening numeric casts and casts between DATE and TIMESTAMP.
+ * Narrowing casts round in PostgreSQL but truncate in Informix.
+ */
+static char *ifxDeparseCast(FuncExpr *func, List *relinfos, List **params)
+{
+	StringInfoData  buf;
+	Oid             srctype;
+	char           *ifxtype = NULL;
+	char           *arg;
+
+	/* length coercions, e.g. varchar(n), carry additional arguments */
+	if (list_length(func->args) != 1)
+		return NULL;
+
+	srctype = exprType((Node *) linitial(func->args));
+
+	switch (func->funcresulttype)
+	{
+		case INT4OID:
+			if (srctype == INT2OID)
+				ifxtype = "INTEGER";
+			break;
+		case INT8OID:
+			if ((srctype == INT2OID) || (srctype == INT4OID))
+				ifxtype = "BIGINT";
+			break;
+		case NUMERICOID:
+			if (isIntegerType(srctype))
+				ifxtype = "DECIMAL(32)";
+			break;
+		case FLOAT4OID:
+			if ((srctype == INT2OID) || (srctype == INT4OID))
+				ifxtype = "SMALLFLOAT";
+			break;
+		case FLOAT8OID:
+			if (isNumericType(srctype) && (srctype != FLOAT8OID))
+				ifxtype = "FLOAT";
+			break;
+		case DATEOID:
+		case TIMESTAMPOID:
+			break;
+		default:
+			return NULL;
+	}
+
+	arg = ifxDeparseRemoteExpr((Node *) linitial(func->args), relinfos, params);
+
+	if (arg == NULL)
+		return NULL;
+
+	initStringInfo(&buf);
+
+	if (ifxtype != NULL)
+		appendStringInfo(&buf, "CAST(%s AS %s)", arg, ifxtype);
+	else if ((func->funcresulttype == DATEOID) && (srctype == TIMESTAMPOID))
+		appendStringInfo(&buf, "DATE(%s)", arg);
+	else if ((func->funcresulttype == TIMESTAMPOID) && (srctype == DATEOID))
+		appendStringInfo(&buf, "EXTEND(%s, YEAR TO SECOND)", arg);
+	else
+		return NULL;
+
+	return buf.data;
+}
+
+/*
+ * Deparses a CASE expression. Both forms, CASE WHEN <cond> and
+ * CASE <expr> WHEN <value>, are supported.
+ */
+static char *ifxDeparseCaseExpr(CaseExpr *caseexpr, List *relinfos,
+								List **params)
+{
+	StringInfoData  buf;
+	ListCell       *cell;
+	char           *deparsed;
+
+	initStringInfo(&buf);
+	appendStringInfoString(&buf, "CASE");
+
+	if (caseexpr->arg != NULL)
+	{
+		deparsed = ifxDeparseRemoteExpr((Node *) caseexpr->arg, relinfos, params);
+
+		if (deparsed == NULL)
+			return NULL;
+
+		appendStringInfo(&buf, " %s", deparsed);
+	}
+
+	foreach(cell, caseexpr->args)
+	{
+		CaseWhen *when = (CaseWhen *) lfirst(cell);
+		Node     *cond = (Node *) when->expr;
+
+		/*
+		 * With CASE <expr>, the parser generated conditions
+		 * of the form <placeholder> = <value>, extract the value.
+		 */
+		if (caseexpr->arg != NULL)
+		{
+			OpExpr             *opr = (OpExpr *) cond;
+			IfxPushdownOprInfo  info;
+			Node               *placeholder;
+
+			if (!IsA(cond, OpExpr)
+				|| (list_length(opr->args) != 2)
+				|| (mapPushdownOperator(opr->opno, &info) != IFX_OPR_EQUAL))
+				return NULL;
+
+			placeholder = (Node *) linitial(opr->args);
+
+			if (IsA(placeholder, RelabelType))
+				placeholder = (Node *) ((RelabelType *) placeholder)->arg;
+
+			if (!IsA(placeholder, CaseTestExpr))
+				return NULL;
+
+			cond = (Node *) lsecond(opr->args);
+		}
+
+		deparsed = ifxDeparseRemoteExpr(cond, relinfos, params);
+
+		if (deparsed == NULL)
+			return NULL;
+
+		appendStringInfo(&buf, " WHEN %s", deparsed);
+
+		deparsed = ifxDeparseRemoteExpr((Node *) when->result, relinfos, params);
+
+		if (deparsed == NULL)
+			return NULL;
+
+		appendStringInfo(&buf, " THEN %s", deparsed);
+	}
+
+	/* CASE without ELSE gets a NULL constant from the parser */
+	if ((caseexpr->defresult != NULL)
+		&& !(IsA(caseexpr->defresult, Const)
+			 && ((Const *) caseexpr->defresult)->constisnull))
+	{
+		deparsed = ifxDeparseRemoteExpr((Node *) caseexpr->defresult, relinfos, params);
+
+		if (deparsed == NULL)
+			return NULL;
+
+		appendStringInfo(&buf, " ELSE %s", deparsed);
+	}
+
+	appendStringInfoString(&buf, " END");
+	return buf.data;
+}
+
+/*
+ * Deparses COALESCE(). Informix doesn't know about
+ * COALESCE() in all versions, so we use nested NVL() calls.
+ */
+static char *ifxDeparseCoalesceExpr(CoalesceExpr *coalesce, List *relinfos,
+									List **params)
+{
+	char *result = NULL;
+	int   i;
+
+	for (i = list_length(coalesce->args) - 1; i >= 0; i--)
+	{
+		char *arg = ifxDeparseRemoteExpr((Node *) list_nth(coalesce->args, i),
+										 relinfos, params);
+
+		if (arg == NULL)
+			return NULL;
+
+		if (result == NULL)
+			result = arg;
+		else
+		{
+			StringInfoData buf;
+
+			initStringInfo(&buf);
+			appendStringInfo(&buf, "NVL(%s, %s)", arg, result);
+			result = buf.data;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * Deparses a function call. Supported are the builtin functions
+ * listed in ifxShippableFunctions and immutable functions declared
+ * shippable by the pushdown_functions option, which are passed with
+ * the same name to Informix.
+ */
+static char *ifxDeparseFuncExpr(FuncExpr *func, List *relinfos, List **params)
+{
+	IfxShippableFunction *entry;
+	StringInfoData        buf;
+	char                 *funcname;
+	int                   nargs;
+
+	if (func->funcformat != COERCE_EXPLICIT_CALL)
+		return ifxDeparseCast(func, relinfos, params);
+
+	funcname = get_func_name(func->funcid);
+
+	if (funcname == NULL)
+		return NULL;
+
+	nargs = list_length(func->args);
+	initStringInfo(&buf);
+
+	if (get_func_namespace(func->funcid) == PG_CATALOG_NAMESPACE)
+	{
+		for (entry = ifxShippableFunctions; entry->pgname != NULL; entry++)
+		{
+			ListCell *cell;
+			bool      args_ok = true;
+
+			if ((strcmp(entry->pgname, funcname) != 0)
+				|| (entry->nargs != nargs))
+				continue;
+
+			/*
+			 * Check the argument types, there might be overloaded
+			 * functions with the same name we don't support.
+			 */
+			switch (entry->argtype)
+			{
+				case IFX_FUNC_ARG_STRING:
+					foreach(cell, func->args)
+					{
+						Oid argtype = exprType((Node *) lfirst(cell));
+
+						if ((cell == list_head(func->args)) ? !isStringType(argtype)
+							: (argtype != INT4OID))
+							args_ok = false;
+					}
+					break;
+				case IFX_FUNC_ARG_VARLEN:
+				{
+					Oid argtype = exprType((Node *) linitial(func->args));
+
+					if ((argtype != TEXTOID) && (argtype != VARCHAROID))
+						args_ok = false;
+					break;
+				}
+				case IFX_FUNC_ARG_SUBSTR:
+				{
+					Node *start = (Node *) lsecond(func->args);
+
+					if (!isStringType(exprType((Node *) linitial(func->args)))
+						|| !IsA(start, Const)
+						|| ((Const *) start)->constisnull
+						|| (((Const *) start)->consttype != INT4OID)
+						|| (DatumGetInt32(((Const *) start)->constvalue) < 1))
+						args_ok = false;
+
+					if ((nargs == 3)
+						&& (exprType((Node *) lthird(func->args)) != INT4OID))
+						args_ok = false;
+					break;
+				}
+				case IFX_FUNC_ARG_NUMERIC:
+					foreach(cell, func->args)
+					{
+						if (!isNumericType(exprType((Node *) lfirst(cell))))
+							args_ok = false;
+					}
+					break;
+				case IFX_FUNC_ARG_DATE_PART:
+				{
+					Node  *field = (Node *) linitial(func->args);
+					char  *fieldname;
+					char *(*datepart)[2];
+					char  *arg;
+
+					if (!IsA(field, Const)
+						|| ((Const *) field)->constisnull
+						|| (((Const *) field)->consttype != TEXTOID)
+						|| (exprType((Node *) lsecond(func->args)) != TIMESTAMPOID))
+						return NULL;
+
+					fieldname = text_to_cstring(DatumGetTextP(((Const *) field)->constvalue));
+					fieldname = asc_tolower(fieldname, strlen(fieldname));
+
+					for (datepart = ifxDatePartFunctions; (*datepart)[0] != NULL; datepart++)
+					{
+						if (strcmp((*datepart)[0], fieldname) == 0)
+							break;
+					}
+
+					if ((*datepart)[0] == NULL)
+						return NULL;
+
+					arg = ifxDeparseRemoteExpr((Node *) lsecond(func->args), relinfos, params);
+
+					if (arg == NULL)
+						return NULL;
+
+					appendStringInfo(&buf, "%s(%s)", (*datepart)[1], arg);
+					return buf.data;
+				}
+			}
+
+			if (!args_ok)
+				return NULL;
+
+			appendStringInfo(&buf, "%s(", entry->ifxname);
+
+			if (!ifxDeparseFuncArgs(&buf, func->args, relinfos, params))
+				return NULL;
+
+			appendStringInfoChar(&buf, ')');
+			return buf.data;
+		}
+	}
+
+	/*
+	 * Not a builtin function we know about, check
+	 * the user supplied list of shippable functions.
+	 */
+	if (!ifxIsUserShippableFunction(func->funcid, funcname, relinfos))
+		return NULL;
+
+	appendStringInfo(&buf, "%s(", funcname);
+
+	if (!ifxDeparseFuncArgs(&buf, func->args, relinfos, params))
+		return NULL;
+
+	appendStringInfoChar(&buf, ')');
+	return buf.data;
+}
+
+/*
+ * Returns the Informix equivalent of the specified operator
+ * not used for comparisons (string concatenation and arithmetic
+ * operators), NULL in case the operator isn't supported.
+ *
+ * NOTE: The integer modulo operator is returned as MOD, which
+ *       must be deparsed as a function call.
+ */
+static char *ifxGetExprOperatorIdent(OpExpr *opr)
+{
+	HeapTuple        oprtuple;
+	Form_pg_operator oprForm;
+	char            *oprname;
+	Oid              oprnamespace;
+	Oid              ltype;
+	Oid              rtype;
+
+	oprtuple = SearchSysCache1(OPEROID, ObjectIdGetDatum(opr->opno));
+
+	if (!HeapTupleIsValid(oprtuple))
+		elog(ERROR, "cache lookup failed for operator %u", opr->opno);
+
+	oprForm      = (Form_pg_operator) GETSTRUCT(oprtuple);
+	oprname      = pstrdup(NameStr(oprForm->oprname));
+	oprnamespace = oprForm->oprnamespace;
+
+	ReleaseSysCache(oprtuple);
+
+	if (oprnamespace != PG_CATALOG_NAMESPACE)
+		return NULL;
+
+	/* prefix operator, only numeric negation is supported */
+	if (list_length(opr->args) == 1)
+	{
+		if ((strcmp(oprname, "-") == 0)
+			&& isNumericType(exprType((Node *) linitial(opr->args))))
+			return "-";
+
+		return NULL;
+	}
+
+	if (list_length(opr->args) != 2)
+		return NULL;
+
+	ltype = exprType((Node *) linitial(opr->args));
+	rtype = exprType((Node *) lsecond(opr->args));
+
+	/*
+	 * Only the builtin text concatenation operator, the polymorphic
+	 * variants (e.g. text || anynonarray) rely on output functions
+	 * of PostgreSQL.
+	 */
+	if ((get_opcode(opr->opno) == F_TEXTCAT)
+		&& isStringType(ltype)
+		&& isStringType(rtype))
+		return "||";
+
+	if (isNumericType(ltype) && isNumericType(rtype))
+	{
+		if ((strcmp(oprname, "+") == 0)
+			|| (strcmp(oprname, "-") == 0)
+			|| (strcmp(oprname, "*") == 0))
+			return oprname;
+
+		/*
+		 * Integer division truncates in PostgreSQL, whereas
+		 * Informix returns a DECIMAL.
+		 */
+		if ((strcmp(oprname, "/") == 0)
+			&& !(isIntegerType(ltype) && isIntegerType(rtype)))
+			return oprname;
+
+		if ((strcmp(oprname, "%") == 0)
+			&& isIntegerType(ltype) && isIntegerType(rtype))
+			return "MOD";
+	}
+
+	/*
+	 * DATE +/- INTEGER and DATE - DATE count in days
+	 * in both PostgreSQL and Informix.
+	 */
+	if ((ltype == DATEOID)
+		&& (((rtype == INT4OID)
+			 && ((strcmp(oprname, "+") == 0) || (strcmp(oprname, "-") == 0)))
+			|| ((rtype == DATEOID) && (strcmp(oprname, "-") == 0))))
+		return oprname;
+
+	return NULL;
+}
+
+/*
+ * Walker for ifxIsExecutorStableExpr(), returns true in case
+ * the expression can't be evaluated during executor startup.
+ */
+static bool ifx_executor_stable_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	/*
+	 * Values of PARAM_EXEC params might change during execution,
+	 * a CaseTestExpr can't be evaluated outside of its CASE expression.
+	 */
+	if ((IsA(node, Param) && (((Param *) node)->paramkind != PARAM_EXTERN))
+		|| IsA(node, CaseTestExpr))
+		return true;
+
+	return expression_tree_walker(node, ifx_executor_stable_walker, context);
+}
+
+/*
+ * Returns true in case the specified expression doesn't change
+ * its value during a scan, but isn't constant during planning either
+ * (e.g. Params of a generic plan or calls to stable functions
+ * like now()). Such expressions are evaluated once during executor
+ * startup and their values are bound to placeholders in the remote
+ * query.
+ */
+static bool ifxIsExecutorStableExpr(Node *node)
+{
+	if (IsA(node, Const))
+		return false;
+
+	if (contain_var_clause(node)
+		|| contain_volatile_functions(node)
+		|| contain_subplans(node)
+		|| contain_agg_clause(node))
+		return false;
+
+	return !ifx_executor_stable_walker(node, NULL);
+}
+
+/*
+ * ifxDeparseParamExpr()
+ *
+ * Deparses an expression evaluated during executor startup into
+ * a placeholder and records it in params. Values are bound as
+ * character strings (see ifxParamValueToString()), so DATE values are
+ * converted with an explicit format, which doesn't depend on GL_DATE.
+ * Returns NULL in case the expression isn't supported.
+ *
+ * NOTE: TIMESTAMP values aren't supported here, since we don't know during
+ *       planning wether a value has more precision than Informix
+ *       supports (see ifxTemporalConstToLiteral()). They can be compared
+ *       with a column, though, see ifxDeparseTimestampParam().
+ */
+static char *ifxDeparseParamExpr(Node *node, List **params)
+{
+	char *placeholder;
+
+	switch (exprType(node))
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case NUMERICOID:
+		case TEXTOID:
+		case VARCHAROID:
+		case BPCHAROID:
+			placeholder = "?";
+			break;
+		case DATEOID:
+			placeholder = "DATE(TO_DATE(?, '%Y-%m-%d'))";
+			break;
+		default:
+			return NULL;
+	}
+
+	*params = lappend(*params, node);
+	return pstrdup(placeholder);
+}
+
+/*
+ * ifxDeparseTimestampParam()
+ *
+ * Deparses a TIMESTAMP or TIMESTAMP WITH TIME ZONE expression evaluated
+ * during executor startup, which is compared by the specified operator
+ * with a TIMESTAMP column, e.g. ts >= now() - interval '1 day'. oprtype
+ * is the operator with the column on its left side. The value is bound
+ * as DATETIME YEAR TO FRACTION(5), TIMESTAMP WITH TIME ZONE values are
+ * converted into the current time zone, as PostgreSQL does when comparing
+ * them with a TIMESTAMP. Returns NULL in case the expression isn't supported.
+ *
+ * Informix values have a precision of 10 microseconds at most, so the
+ * value is truncated during conversion (see ifxParamValueToString()).
+ * col > value and col <= value still give the same results. For
+ * col >= value and col < value we need to round up instead, which is done
+ * by adding 9 microseconds before truncation. Equality can't be decided this
+ * way, so it isn't supported.
+ */
+static char *ifxDeparseTimestampParam(Node *node, IfxOprType oprtype,
+									  List **params)
+{
+	Oid       valtype = exprType(node);
+	Oid       plusopr;
+	Interval *span;
+	Const    *round_up;
+	OpExpr   *opr;
+
+	if ((valtype != TIMESTAMPOID) && (valtype != TIMESTAMPTZOID))
+		return NULL;
+
+	switch (oprtype)
+	{
+		case IFX_OPR_GT:
+		case IFX_OPR_LE:
+			*params = lappend(*params, node);
+			return pstrdup("TO_DATE(?, '%Y-%m-%d %H:%M:%S%F5')");
+		case IFX_OPR_GE:
+		case IFX_OPR_LT:
+			break;
+		default:
+			return NULL;
+	}
+
+	plusopr = OpernameGetOprid(list_make1(makeString("+")), valtype, INTERVALOID);
+
+	if (plusopr == InvalidOid)
+		return NULL;
+
+	span = (Interval *) palloc0(sizeof(Interval));
+#if defined(HAVE_INT64_TIMESTAMP) || PG_VERSION_NUM >= 100000
+	span->time = 9;
+#else
+	span->time = 0.000009;
+#endif
+
+	round_up = makeConst(INTERVALOID, -1, InvalidOid, sizeof(Interval),
+						 IntervalPGetDatum(span), false, false);
+	opr = (OpExpr *) make_opclause(plusopr, valtype, false, (Expr *) node,
+								   (Expr *) round_up, InvalidOid, InvalidOid);
+	set_opfuncid(opr);
+
+	*params = lappend(*params, opr);
+	return pstrdup("TO_DATE(?, '%Y-%m-%d %H:%M:%S%F5')");
+}
+
+/*
+ * ifxParamValueToString()
+ *
+ * Converts the value of an expression deparsed by ifxDeparseParamExpr()
+ * into a character string to be bound to its placeholder.
+ */
+char *ifxParamValueToString(Datum value, Oid typeOid)
+{
+	switch (typeOid)
+	{
+		case DATEOID:
+		{
+			DateADT date = DatumGetDateADT(value);
+			int     year;
+			int     month;
+			int     day;
+			char    buf[MAXDATELEN + 1];
+
+			if (DATE_NOT_FINITE(date))
+				ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_DATA_TYPE),
+								errmsg("cannot pass infinite date value to informix")));
+
+			j2date(date + POSTGRES_EPOCH_JDATE, &year, &month, &day);
+			snprintf(buf, sizeof(buf), "%04d-%02d-%02d", year, month, day);
+
+			return pstrdup(buf);
+		}
+		case TIMESTAMPOID:
+		case TIMESTAMPTZOID:
+		{
+			Timestamp    ts = DatumGetTimestamp(value);
+			struct pg_tm tm;
+			fsec_t       fsec;
+			int          tz;
+			char         buf[MAXDATELEN + 1];
+
+			if (TIMESTAMP_NOT_FINITE(ts))
+				ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_DATA_TYPE),
+								errmsg("cannot pass infinite timestamp value to informix")));
+
+			if ((timestamp2tm(ts, (typeOid == TIMESTAMPTZOID) ? &tz : NULL,
+							  &tm, &fsec, NULL, NULL) != 0)
+				|| (tm.tm_year < 1) || (tm.tm_year > 9999))
+				ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_DATA_TYPE),
+								errmsg("timestamp value out of range for informix")));
+
+			/* truncate to FRACTION(5), see ifxDeparseTimestampParam() */
+			snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d.%05d",
+					 tm.tm_year, tm.tm_mon, tm.tm_mday,
+					 tm.tm_hour, tm.tm_min, tm.tm_sec,
+					 (int) (IFX_TIME_TO_USECS(fsec) / 10));
+
+			return pstrdup(buf);
+		}
+		default:
+		{
+			Oid  typoutput;
+			bool typisvarlena;
+
+			getTypeOutputInfo(typeOid, &typoutput, &typisvarlena);
+			return OidOutputFunctionCall(typoutput, value);
+		}
+	}
+}
+
+/*
+ * ifxKeyTableColumnType()
+ *
+ * Returns the Informix type of the key table column storing
+ * values of the specified type, or NULL in case the type
+ * isn't supported for key tables.
+ */
+char *ifxKeyTableColumnType(Oid typeOid)
+{
+	switch (typeOid)
+	{
+		case INT2OID:
+		case INT4OID:
+			return "INTEGER";
+		case INT8OID:
+			return "INT8";
+		case NUMERICOID:
+			return "DECIMAL(32)";
+		default:
+			return NULL;
+	}
+}
+
+/*
+ * ifxDeparseKeySet()
+ *
+ * Deparses <column> = ANY(<array>) into a subquery on a key table,
+ * which is loaded with the elements of the array during executor
+ * startup (see ifxLoadKeyTables()). The key set is recorded in the
+ * context. Returns NULL in case the expression isn't suitable to be
+ * shipped via a key table.
+ *
+ * This is done for constant arrays too large to fit into a single
+ * IN list and for arrays evaluated during executor startup (e.g. Params
+ * of a generic plan), which can't be pushed down otherwise.
+ */
+static char *ifxDeparseKeySet(ScalarArrayOpExpr *expr, Var *operand,
+							  IfxPushdownOprContext *context)
+{
+	IfxPushdownOprInfo  info;
+	IfxKeySet          *key_set;
+	Node               *array_expr;
+	Oid                 elemtype;
+	StringInfoData      buf;
+
+	if (!expr->useOr
+		|| (list_length(expr->args) != 2)
+		|| (mapPushdownOperator(expr->opno, &info) != IFX_OPR_EQUAL))
+		return NULL;
+
+	array_expr = (Node *) lsecond(expr->args);
+	elemtype   = get_element_type(exprType(array_expr));
+
+	/*
+	 * Key tables support a few numeric types only. Integer
+	 * types of different width compare fine on the Informix server.
+	 */
+	if ((ifxKeyTableColumnType(elemtype) == NULL)
+		|| (ifxKeyTableColumnType(operand->vartype) == NULL))
+		return NULL;
+
+	if ((operand->vartype != elemtype)
+		&& ((operand->vartype == NUMERICOID) || (elemtype == NUMERICOID)))
+		return NULL;
+
+	if (IsA(array_expr, Const))
+	{
+		Const     *array_const = (Const *) array_expr;
+		ArrayType *array;
+
+		if (array_const->constisnull)
+			return NULL;
+
+		/* smaller arrays are pushed down as an IN list */
+		array = DatumGetArrayTypeP(array_const->constvalue);
+		if (ArrayGetNItems(ARR_NDIM(array), ARR_DIMS(array)) <= IFX_IN_LIST_CHUNK_SIZE)
+			return NULL;
+	}
+	else if (!context->allow_params || !ifxIsExecutorStableExpr(array_expr))
+		return NULL;
+
+	/*
+	 * A NULL array evaluated at runtime leaves the key table empty,
+	 * giving false instead of NULL, which only doesn't matter
+	 * for a top-level qual.
+	 */
+	if (!IsA(array_expr, Const) && !context->toplevel)
+		return NULL;
+
+	key_set = palloc(sizeof(IfxKeySet));
+	key_set->expr = (Expr *) array_expr;
+
+	/*
+	 * The key table is named after the statement refid of the scan
+	 * and the position of the key set within the predicate. The refid
+	 * is unique within the session of the remote connection, so scans
+	 * open at the same time never share a key table.
+	 */
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "ifxfdw_keys_%u_%d_%d",
+					 context->foreign_relid,
+					 context->key_set_refid,
+					 context->key_set_base + list_length(context->key_sets));
+	key_set->tablename = buf.data;
+
+	context->key_sets = lappend(context->key_sets, key_set);
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "%s IN (SELECT %s FROM %s)",
+					 ifxGetRemoteColumnName(context->foreign_relid,
+											operand->varattno),
+					 IFX_KEY_TABLE_COLUMN, key_set->tablename);
+
+	return buf.data;
+}
+
+#if PG_VERSION_NUM >= 90300
+
+/*
+ * Returns true if the specified operator is the builtin
+ * equality operator of its argument types.
+ */
+static bool isCatalogEqualityOperator(Oid opno)
+{
+	HeapTuple        oprtuple;
+	Form_pg_operator oprForm;
+	bool             result;
+
+	oprtuple = SearchSysCache1(OPEROID, ObjectIdGetDatum(opno));
+
+	if (!HeapTupleIsValid(oprtuple))
+		elog(ERROR, "cache lookup failed for operator %u", opno);
+
+	oprForm = (Form_pg_operator) GETSTRUCT(oprtuple);
+	result  = ((strcmp(NameStr(oprForm->oprname), "=") == 0)
+			   && (oprForm->oprnamespace == PG_CATALOG_NAMESPACE));
+
+	ReleaseSysCache(oprtuple);
+
+	return result;
+}
+
+/*
+ * ifxDeparseParamJoinClause()
+ *
+ * Deparses an equality join clause <column> = <outer expression> into
+ * a predicate of the specified foreign table, where the expression
+ * referencing other relations is bound to a placeholder and appended
+ * to params. The placeholder gets its value each time the foreign scan
+ * is (re)started, e.g. as the inner side of a nested loop.
+ *
+ * Returns NULL in case the clause isn't supported. The column must be
+ * of a type with compatible equality semantics, see
+ * ifxIsCompatibleForEquality().
+ */
+char *ifxDeparseParamJoinClause(Expr *clause, Index rtid,
+								Oid foreignRelid, List **params)
+{
+	OpExpr *opr;
+	Node   *larg;
+	Node   *rarg;
+	Var    *var;
+	Node   *outer;
+	Oid     vartype;
+	Oid     outertype;
+	char   *placeholder;
+	StringInfoData buf;
+
+	if (!IsA(clause, OpExpr))
+		return NULL;
+
+	opr = (OpExpr *) clause;
+
+	if ((list_length(opr->args) != 2)
+		|| !isCatalogEqualityOperator(opr->opno))
+		return NULL;
+
+	larg = (Node *) linitial(opr->args);
+	rarg = (Node *) lsecond(opr->args);
+
+	/* see T_RelabelType handling in ifx_predicate_tree_walker() */
+	if (IsA(larg, RelabelType))
+		larg = (Node *) ((RelabelType *) larg)->arg;
+	if (IsA(rarg, RelabelType))
+		rarg = (Node *) ((RelabelType *) rarg)->arg;
+
+	/*
+	 * Find out which side references the foreign table.
+	 */
+	if (IsA(larg, Var) && (((Var *) larg)->varno == rtid))
+	{
+		var   = (Var *) larg;
+		outer = rarg;
+	}
+	else if (IsA(rarg, Var) && (((Var *) rarg)->varno == rtid))
+	{
+		var   = (Var *) rarg;
+		outer = larg;
+	}
+	else
+		return NULL;
+
+	if ((var->varlevelsup != 0) || (var->varattno <= 0))
+		return NULL;
+
+	/*
+	 * The outer expression must not reference the foreign
+	 * table itself and must be evaluable locally.
+	 */
+	if (bms_is_member(rtid, pull_varnos(outer))
+		|| contain_volatile_functions(outer)
+		|| contain_subplans(outer)
+		|| contain_agg_clause(outer))
+		return NULL;
+
+	vartype   = exprType((Node *) var);
+	outertype = exprType(outer);
+
+	if (!ifxIsCompatibleForEquality(vartype)
+		|| !((vartype == outertype)
+			 || (isIntegerType(vartype) && isIntegerType(outertype))))
+		return NULL;
+
+	placeholder = ifxDeparseParamExpr(outer, params);
+
+	if (placeholder == NULL)
+		return NULL;
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "%s = %s",
+					 ifxGetRemoteColumnName(foreignRelid, var->varattno),
+					 placeholder);
+
+	return buf.data;
+}
+
+#endif
+
+/*
+ * ifxDeparseRemoteExpr()
+ *
+ * Deparses an expression to be evaluated by the Informix server,
+ * e.g. during aggregate or join pushdown. relinfos is a list of
+ * IfxDeparseRelInfo describing the foreign tables which might be
+ * referenced by the expression. Returns NULL in case the expression
+ * (or any part of it) can't be pushed down.
+ *
+ * Supported are column references of the specified foreign tables,
+ * constants, aggregates (see ifxDeparseAggref()), operators supported by
+ * predicate pushdown, string concatenation, shippable functions (see
+ * ifxDeparseFuncExpr()), IN lists, boolean expressions and NULL tests.
+ *
+ * In case params is a valid pointer, expressions evaluated during executor
+ * startup are deparsed into placeholders and appended to params (see
+ * ifxDeparseParamExpr()). Otherwise they're not supported.
+ */
+char *ifxDeparseRemoteExpr(Node *node, List *relinfos, List **params)
+{
+	if (node == NULL)
+		return NULL;
+
+	if ((params != NULL) && ifxIsExecutorStableExpr(node))
+		return ifxDeparseParamExpr(node, params);
+
+	switch(node->type)
+	{
+		case T_Var:
+		{
+			Var               *var = (Var *) node;
+			IfxDeparseRelInfo *relinfo = NULL;
+			ListCell          *cell;
+			char              *colname;
+
+			if ((var->varlevelsup != 0)
+				|| (var->varattno <= 0))
+				return NULL;
+
+			foreach(cell, relinfos)
+			{
+				if (((IfxDeparseRelInfo *) lfirst(cell))->rtid == var->varno)
+				{
+					relinfo = (IfxDeparseRelInfo *) lfirst(cell);
+					break;
+				}
+			}
+
+			/* not a column of any foreign table in question */
+			if (relinfo == NULL)
+				return NULL;
+
+			colname = ifxGetRemoteColumnName(relinfo->foreignRelid,
+											 var->varattno);
+
+			if (relinfo->alias != NULL)
+			{
+				StringInfoData buf;
+
+				initStringInfo(&buf);
+				appendStringInfo(&buf, "%s.%s", relinfo->alias, colname);
+				return buf.data;
+			}
+
+			return colname;
+		}
+		case T_RelabelType:
+		{
+			RelabelType *r = (RelabelType *) node;
+
+			/* binary compatible types, deparse the argument as-is */
+			return ifxDeparseRemoteExpr((Node *) r->arg, relinfos, params);
+		}
+		case T_Const:
+		{
+			Const *const_val = (Const *) node;
+			Const *converted_const;
+			bool   converted = false;
+			bool   supported = true;
+
+			if (!isCompatibleForPushdown(const_val->consttype))
+				return NULL;
+
+			converted_const = ifxConvertNodeConst(const_val, &converted,
+												  &supported);
+
+			if (!supported)
+				return NULL;
+
+			return ifxDeparseConst(converted_const);
+		}
+#if PG_VERSION_NUM >= 90500
+		case T_Aggref:
+			return ifxDeparseAggref((Aggref *) node, relinfos, params);
+#endif
+		case T_FuncExpr:
+			return ifxDeparseFuncExpr((FuncExpr *) node, relinfos, params);
+		case T_CaseExpr:
+			return ifxDeparseCaseExpr((CaseExpr *) node, relinfos, params);
+		case T_CoalesceExpr:
+			return ifxDeparseCoalesceExpr((CoalesceExpr *) node, relinfos, params);
+		case T_ScalarArrayOpExpr:
+		{
+			ScalarArrayOpExpr *saop = (ScalarArrayOpExpr *) node;
+
+			return ifxDeparseScalarArrayOpExpr(saop,
+											   ifxDeparseRemoteExpr((Node *) linitial(saop->args),
+																	relinfos, params),
+											   false);
+		}
+		case T_OpExpr:
+		{
+			OpExpr             *opr = (OpExpr *) node;
+			IfxPushdownOprInfo  info;
+			IfxOprType          oprtype = IFX_OPR_NOT_SUPPORTED;
+			StringInfoData      buf;
+			char               *oprstr;
+			char               *left;
+			char               *right;
+
+			if ((list_length(opr->args) == 2)
+				&& ((oprtype = mapPushdownOperator(opr->opno, &info)) != IFX_OPR_NOT_SUPPORTED))
+				oprstr = getIfxOperatorIdent(&info);
+			else if ((oprstr = ifxGetExprOperatorIdent(opr)) == NULL)
+				return NULL;
+
+			if (!ifxIntervalOperandsMatch(opr, relinfos))
+				return NULL;
+
+			initStringInfo(&buf);
+
+			if (list_length(opr->args) == 1)
+			{
+				right = ifxDeparseRemoteExpr((Node *) linitial(opr->args), relinfos, params);
+
+				if (right == NULL)
+					return NULL;
+
+				appendStringInfo(&buf, "(%s %s)", oprstr, right);
+				return buf.data;
+			}
+
+			left  = NULL;
+			right = NULL;
+
+			/*
+			 * A TIMESTAMP column compared with a timestamp evaluated
+			 * during executor startup, see ifxDeparseTimestampParam().
+			 */
+			if ((params != NULL)
+				&& (oprtype != IFX_OPR_NOT_SUPPORTED))
+			{
+				Node *larg = (Node *) linitial(opr->args);
+				Node *rarg = (Node *) lsecond(opr->args);
+
+				if (!ifxIsExecutorStableExpr(larg)
+					&& (exprType(larg) == TIMESTAMPOID)
+					&& ifxIsExecutorStableExpr(rarg))
+				{
+					right = ifxDeparseTimestampParam(rarg, oprtype, params);
+				}
+				else if (!ifxIsExecutorStableExpr(rarg)
+						 && (exprType(rarg) == TIMESTAMPOID)
+						 && ifxIsExecutorStableExpr(larg))
+				{
+					/* commute the operator, the column is on the right */
+					switch (oprtype)
+					{
+						case IFX_OPR_GE:
+							left = ifxDeparseTimestampParam(larg, IFX_OPR_LE, params);
+							break;
+						case IFX_OPR_LE:
+							left = ifxDeparseTimestampParam(larg, IFX_OPR_GE, params);
+							break;
+						case IFX_OPR_GT:
+							left = ifxDeparseTimestampParam(larg, IFX_OPR_LT, params);
+							break;
+						case IFX_OPR_LT:
+							left = ifxDeparseTimestampParam(larg, IFX_OPR_GT, params);
+							break;
+						default:
+							break;
+					}
+				}
+			}
+
+			if (left == NULL)
+				left = ifxDeparseRemoteExpr((Node *) linitial(opr->args), relinfos, params);
+			if (right == NULL)
+				right = ifxDeparseRemoteExpr((Node *) lsecond(opr->args), relinfos, params);
+
+			if ((left == NULL) || (right == NULL))
+				return NULL;
+
+			if (strcmp(oprstr, "MOD") == 0)
+				appendStringInfo(&buf, "MOD(%s, %s)", left, right);
+			else
+				appendStringInfo(&buf, "(%s %s %s)", left, oprstr, right);
+
+			return buf.data;
+		}
+		case T_BoolExpr:
+		{
+			BoolExpr       *boolexpr = (BoolExpr *) node;
+			StringInfoData  buf;
+			ListCell       *cell;
+			char           *boolop;
+
+			switch(boolexpr->boolop)
+			{
+				case AND_EXPR:
+					boolop = " AND ";
+					break;
+				case OR_EXPR:
+					boolop = " OR ";
+					break;
+				case NOT_EXPR:
+				{
+					char *arg;
+
+					arg = ifxDeparseRemoteExpr((Node *) linitial(boolexpr->args), relinfos, params);
+
+					if (arg == NULL)
+						return NULL;
+
+					initStringInfo(&buf);
+					appendStringInfo(&buf, "(NOT %s)", arg);
+					return buf.data;
+				}
+				default:
+					return NULL;
+			}
+
+			initStringInfo(&buf);
+			appendStringInfoChar(&buf, '(');
+
+			foreach(cell, boolexpr->args)
+			{
+				char *arg;
+
+				arg = ifxDeparseRemoteExpr((Node *) lfirst(cell), relinfos, params);
+
+				if (arg == NULL)
+					return NULL;
+
+				appendStringInfo(&buf, "%s%s",
+								 (cell == list_head(boolexpr->args)) ? "" : boolop,
+								 arg);
+			}
+
+			appendStringInfoChar(&buf, ')');
+			return buf.data;
+		}
+		case T_NullTest:
+		{
+			NullTest       *ntest = (NullTest *) node;
+			StringInfoData  buf;
+			char           *arg;
+
+			if (ntest->argisrow)
+				return NULL;
+
+			arg = ifxDeparseRemoteExpr((Node *) ntest->arg, relinfos, params);
+
+			if (arg == NULL)
+				return NULL;
+
+			initStringInfo(&buf);
+			appendStringInfo(&buf, "(%s %s)", arg,
+							 (ntest->nulltesttype == IS_NULL) ? "IS NULL" : "IS NOT NULL");
+			return buf.data;
+		}
+		default:
+			break;
+	}
+
+	/* not supported */
+	return NULL;
+}
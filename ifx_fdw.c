@@ -16,14 +16,46 @@
 #include "ifx_node_utils.h"
 #include "ifx_conncache.h"
 
+#include <ctype.h>
+
 #if PG_VERSION_NUM >= 90300
 #include "access/htup_details.h"
 #include "access/sysattr.h"
+#include "optimizer/paths.h"
 #include "parser/parsetree.h"
 #endif
 
 #include "access/xact.h"
+#include "nodes/nodeFuncs.h"
 #include "utils/lsyscache.h"
+#include "optimizer/clauses.h"
+#include "optimizer/var.h"
+#include "access/heapam.h"
+#include "utils/syscache.h"
+#include "catalog/namespace.h"
+#include "tcop/utility.h"
+
+#if PG_VERSION_NUM >= 90300
+#include "catalog/pg_class.h"
+#include "executor/spi.h"
+#include "pgstat.h"
+#include "postmaster/bgworker.h"
+#include "storage/ipc.h"
+#include "storage/latch.h"
+#include "storage/proc.h"
+#include "utils/guc.h"
+#include "utils/datum.h"
+#include "utils/memutils.h"
+#include "utils/snapmgr.h"
+#endif
+
+#if PG_VERSION_NUM >= 90500
+#include "optimizer/tlist.h"
+#endif
+
+#if PG_VERSION_NUM >= 90600
+#include "utils/selfuncs.h"
+#endif
 
 PG_MODULE_MAGIC;
 
@@ -61,6 +93,12 @@ static struct IfxFdwOption ifx_valid_options[] =
 	{ "disable_predicate_pushdown", ForeignTableRelationId },
 	{ "disable_rowid",              ForeignTableRelationId },
 	{ "enable_blobs",               ForeignTableRelationId },
+	{ "enable_key_tables",          ForeignTableRelationId },
+	{ "batch_size",                 ForeignServerRelationId },
+	{ "batch_size",                 ForeignTableRelationId },
+	{ "pushdown_functions",         ForeignServerRelationId },
+	{ "pushdown_functions",         ForeignTableRelationId },
+	{ "column_name",                AttributeRelationId },
 	{ NULL,                         ForeignTableRelationId }
 };
 
@@ -114,6 +152,173 @@ PG_FUNCTION_INFO_V1(ifxCloseConnection);
 #define IFX_SYSTABLE_SCAN_SNAPSHOT NULL
 #endif
 
+#ifndef TupleDescAttr
+#define TupleDescAttr(tupdesc, i) ((tupdesc)->attrs[(i)])
+#endif
+
+/*
+ * create_foreignscan_path() and make_foreignscan() got additional
+ * arguments with PostgreSQL 9.5 and 9.6. The target argument is ignored
+ * on releases not supporting upper relations.
+ */
+#if PG_VERSION_NUM >= 90600
+#define IFX_CREATE_FOREIGNSCAN_PATH(root, rel, target, rows, startup, total, pathkeys, private) \
+	create_foreignscan_path((root), (rel), (target), (rows), (startup), (total), \
+							(pathkeys), NULL, NULL, (private))
+#elif PG_VERSION_NUM >= 90500
+#define IFX_CREATE_FOREIGNSCAN_PATH(root, rel, target, rows, startup, total, pathkeys, private) \
+	create_foreignscan_path((root), (rel), (rows), (startup), (total), \
+							(pathkeys), NULL, NULL, (private))
+#else
+#define IFX_CREATE_FOREIGNSCAN_PATH(root, rel, target, rows, startup, total, pathkeys, private) \
+	create_foreignscan_path((root), (rel), (rows), (startup), (total), \
+							(pathkeys), NULL, (private))
+#endif
+
+/*
+ * Same for parameterized foreign paths of a base relation.
+ */
+#if PG_VERSION_NUM >= 90600
+#define IFX_CREATE_FOREIGNSCAN_PARAM_PATH(root, rel, rows, startup, total, outer, private) \
+	create_foreignscan_path((root), (rel), NULL, (rows), (startup), (total), \
+							NIL, (outer), NULL, (private))
+#elif PG_VERSION_NUM >= 90500
+#define IFX_CREATE_FOREIGNSCAN_PARAM_PATH(root, rel, rows, startup, total, outer, private) \
+	create_foreignscan_path((root), (rel), (rows), (startup), (total), \
+							NIL, (outer), NULL, (private))
+#else
+#define IFX_CREATE_FOREIGNSCAN_PARAM_PATH(root, rel, rows, startup, total, outer, private) \
+	create_foreignscan_path((root), (rel), (rows), (startup), (total), \
+							NIL, (outer), (private))
+#endif
+
+#if PG_VERSION_NUM >= 90500
+#define IFX_MAKE_FOREIGNSCAN(tlist, qual, relid, exprs, private, scan_tlist) \
+	make_foreignscan((tlist), (qual), (relid), (exprs), (private), \
+					 (scan_tlist), NIL, NULL)
+#else
+#define IFX_MAKE_FOREIGNSCAN(tlist, qual, relid, exprs, private, scan_tlist) \
+	make_foreignscan((tlist), (qual), (relid), (exprs), (private))
+#endif
+
+/*
+ * Expression evaluation was rewritten with PostgreSQL 10.
+ */
+#if PG_VERSION_NUM >= 100000
+#define IFX_EXEC_INIT_EXPR_LIST(exprs, parent) ExecInitExprList((exprs), (parent))
+#define IFX_EXEC_EVAL_EXPR(exprstate, econtext, isnull) \
+	ExecEvalExpr((exprstate), (econtext), (isnull))
+#else
+#define IFX_EXEC_INIT_EXPR_LIST(exprs, parent) \
+	((List *) ExecInitExpr((Expr *) (exprs), (parent)))
+#define IFX_EXEC_EVAL_EXPR(exprstate, econtext, isnull) \
+	ExecEvalExpr((exprstate), (econtext), (isnull), NULL)
+#endif
+
+/*
+ * The target list of a relation moved into a PathTarget
+ * with PostgreSQL 9.6, its width as well.
+ */
+#if PG_VERSION_NUM >= 90600
+#define IFX_REL_TARGET_EXPRS(rel) ((rel)->reltarget->exprs)
+#elif PG_VERSION_NUM >= 90500
+#define IFX_REL_TARGET_EXPRS(rel) ((rel)->reltargetlist)
+#endif
+
+#if PG_VERSION_NUM >= 90600
+#define IFX_REL_TARGET_WIDTH(rel) ((rel)->reltarget->width)
+#else
+#define IFX_REL_TARGET_WIDTH(rel) ((rel)->width)
+#endif
+
+/*
+ * The arguments of ProcessUtility() changed with PostgreSQL 9.3
+ * and 10.
+ */
+#if PG_VERSION_NUM >= 100000
+#define IFX_PROCESS_UTILITY_ARGS PlannedStmt *pstmt, const char *queryString, \
+		ProcessUtilityContext context, ParamListInfo params, \
+		QueryEnvironment *queryEnv, DestReceiver *dest, char *completionTag
+#define IFX_PROCESS_UTILITY_CALL pstmt, queryString, context, params, \
+		queryEnv, dest, completionTag
+#define IFX_PROCESS_UTILITY_PARSETREE (pstmt->utilityStmt)
+#elif PG_VERSION_NUM >= 90300
+#define IFX_PROCESS_UTILITY_ARGS Node *parsetree, const char *queryString, \
+		ProcessUtilityContext context, ParamListInfo params, \
+		DestReceiver *dest, char *completionTag
+#define IFX_PROCESS_UTILITY_CALL parsetree, queryString, context, params, \
+		dest, completionTag
+#define IFX_PROCESS_UTILITY_PARSETREE (parsetree)
+#else
+#define IFX_PROCESS_UTILITY_ARGS Node *parsetree, const char *queryString, \
+		ParamListInfo params, bool isTopLevel, DestReceiver *dest, \
+		char *completionTag
+#define IFX_PROCESS_UTILITY_CALL parsetree, queryString, params, isTopLevel, \
+		dest, completionTag
+#define IFX_PROCESS_UTILITY_PARSETREE (parsetree)
+#endif
+
+/*
+ * Startup costs of a parameterized foreign path, which reopens
+ * the remote cursor for each set of parameter values.
+ */
+#define IFX_PARAM_PATH_STARTUP_COST 100.0
+
+/*
+ * Assumed number of index levels the Informix server
+ * traverses for a lookup via a remote index. Each level is
+ * charged with random_page_cost.
+ */
+#define IFX_INDEX_TREE_HEIGHT 3
+
+/*
+ * Minimum version of the Informix server supporting
+ * derived tables, see ifxQueryAllowsDerivedTable().
+ */
+#define IFX_DERIVED_TABLE_MIN_VERSION 1150
+
+/*
+ * Minimum version of the Informix server supporting
+ * NULLS FIRST and NULLS LAST within ORDER BY.
+ */
+#define IFX_NULLS_ORDERING_MIN_VERSION 1210
+
+/*
+ * SQLCODEs returned by Informix when creating an
+ * already existing (temp) table.
+ */
+#define IFX_TABLE_EXISTS      -310
+#define IFX_TEMP_TABLE_EXISTS -958
+
+/*
+ * Number of rows per requested sample row ANALYZE asks
+ * the Informix server for when sampling remotely, so that
+ * the reservoir still has a choice.
+ */
+#define IFX_SAMPLE_OVERSAMPLING 3
+
+/*
+ * Maximum number of ROWIDs a batched UPDATE or DELETE passes
+ * per statement, regardless of batch_size. Keeps the ROWID
+ * list and the number of placeholders of the SQLDA small.
+ */
+#define IFX_MAX_ROWID_BATCH 64
+
+/*
+ * Layout of the private list attached to foreign paths
+ * by ifxAddForeignPath().
+ */
+#define IFX_PATH_PRIVATE_SORT_CLAUSE 0
+#define IFX_PATH_PRIVATE_LIMIT_COUNT 1
+
+/*
+ * Layout of the private list attached to a foreign scan
+ * performing a direct UPDATE or DELETE, see ifxPlanDirectModify().
+ */
+#define IFX_DIRECT_MODIFY_QUERY         0
+#define IFX_DIRECT_MODIFY_SET_PROCESSED 1
+#define IFX_DIRECT_MODIFY_SCAN_PRIVATE  2
+
 /*******************************************************************************
  * FDW helper functions.
  */
@@ -152,6 +357,9 @@ ifxGenDescrName(IfxConnectionInfo *coninfo, int descr_id);
 static void
 ifxGetOptionDups(IfxConnectionInfo *coninfo, DefElem *def);
 
+static int
+ifxGetBatchSizeOption(DefElem *def);
+
 static void ifxConnInfoSetDefaults(IfxConnectionInfo *coninfo);
 
 static IfxConnectionInfo *ifxMakeConnectionInfo(Oid foreignTableOid);
@@ -160,6 +368,11 @@ static char *ifxGenCursorName(IfxConnectionInfo *coninfo, int curid);
 
 static void ifxPgColumnData(Oid foreignTableOid, IfxFdwExecutionState *festate);
 
+#if PG_VERSION_NUM >= 90500
+static void ifxPgColumnDataFromTupleDesc(TupleDesc tupdesc,
+										 IfxFdwExecutionState *festate);
+#endif
+
 static IfxSqlStateClass
 ifxCatchExceptions(IfxStatementInfo *state, unsigned short stackentry);
 
@@ -178,11 +391,36 @@ static void ifxPrepareCursorForScan(IfxStatementInfo *info,
 static char *ifxFilterQuals(PlannerInfo *planInfo,
 							RelOptInfo *baserel,
 							List **excl_restrictInfo,
-							Oid foreignTableOid);
+							Oid foreignTableOid,
+							IfxConnectionInfo *coninfo,
+							List **params,
+							List **key_sets,
+							int refid);
+
+static void ifxOpenScanCursor(IfxFdwExecutionState *state);
+
+#if PG_VERSION_NUM >= 90200
+static void ifxEstimateScanLocally(PlannerInfo *root,
+								   RelOptInfo *baserel,
+								   IfxConnectionInfo *coninfo,
+								   IfxFdwExecutionState *state);
+static void ifxCreateKeyTable(IfxStatementInfo *info, char *tablename,
+							  Oid elemtype);
+static void ifxLoadKeyTables(IfxFdwExecutionState *state,
+							 ForeignScanState *node);
+#endif
+
+#if PG_VERSION_NUM >= 90200
+static void ifxEvalParamExprs(IfxFdwExecutionState *state,
+							  ForeignScanState *node);
+#endif
 
 static void ifxPrepareParamsForScan(IfxFdwExecutionState *state,
 									IfxConnectionInfo *coninfo);
 
+static int ifxGetCachedServerVersion(IfxConnectionInfo *coninfo);
+static bool ifxQueryAllowsDerivedTable(IfxConnectionInfo *coninfo);
+
 static IfxSqlStateClass
 ifxFetchTuple(IfxFdwExecutionState *state);
 
@@ -197,12 +435,15 @@ static HeapTuple ifxFdwMakeTuple(IfxFdwExecutionState *state,
 
 static ItemPointer ifxGetRowIdForTuple(IfxFdwExecutionState *state);
 
-__attribute__((unused)) static bool ifxCheckForAfterRowTriggers(Oid foreignTableOid,
-															   IfxFdwExecutionState *state,
-															   CmdType cmd);
+static bool ifxCheckForAfterRowTriggers(Oid foreignTableOid,
+										IfxFdwExecutionState *state,
+										CmdType cmd);
 
 #if PG_VERSION_NUM >= 90300
 
+static int ifxGetJunkRowId(IfxFdwExecutionState *state,
+						   TupleTableSlot       *planSlot);
+
 static void ifxRowIdValueToSqlda(IfxFdwExecutionState *state,
 								 int                   paramId,
 								 TupleTableSlot       *planSlot);
@@ -217,9 +458,22 @@ static void ifxPrepareParamsForModify(IfxFdwExecutionState *state,
 									  ModifyTable          *plan,
 									  Oid                   foreignTableOid);
 
+static bool ifxModifyValuesRowInvariant(IfxFdwExecutionState *state,
+										ModifyTable          *plan,
+										int                   subplan_index);
+
 static void ifxColumnValuesToSqlda(IfxFdwExecutionState *state,
 								   TupleTableSlot *slot,
 								   int attnum);
+static void ifxCheckInsertBatch(IfxFdwExecutionState *state, bool flush);
+static void ifxInsertBatchErrorCallback(void *arg);
+static void ifxModifyBatchAddRow(IfxFdwExecutionState *state,
+								 TupleTableSlot *planSlot);
+static void ifxFlushModifyBatch(IfxFdwExecutionState *state);
+static bool ifxModifyBatchValuesEqual(IfxFdwExecutionState *state,
+									  TupleTableSlot *slot);
+static void ifxModifyBatchSaveValues(IfxFdwExecutionState *state,
+									 TupleTableSlot *slot);
 static IfxFdwExecutionState *ifxCopyExecutionState(IfxFdwExecutionState *state);
 
 static int
@@ -237,6 +491,8 @@ ifxExplainForeignModify(ModifyTableState *mstate,
 static void ifx_fdw_xact_callback(XactEvent event, void *arg);
 static void ifx_fdw_xact_callback_internal(IfxCachedConnection *cached,
 										   XactEvent event);
+static void ifxDropKeyTables(IfxCachedConnection *cached);
+static void ifxDropScanKeyTables(IfxFdwExecutionState *state);
 static int ifxXactFinalize(IfxCachedConnection *cached,
 						   IfxXactAction action,
 						   bool connection_error_ok);
@@ -250,6 +506,45 @@ static void ifx_fdw_subxact_callback(SubXactEvent event,
  */
 void _PG_init(void);
 
+#if PG_VERSION_NUM >= 90200
+
+/*
+ * Column lists of the relations passed to the currently
+ * executed ANALYZE command (list of IfxAnalyzeColumns).
+ */
+static List *ifx_analyze_columns = NIL;
+
+static ProcessUtility_hook_type prev_ProcessUtility = NULL;
+
+static void ifxProcessUtility(IFX_PROCESS_UTILITY_ARGS);
+static Bitmapset *ifxGetAnalyzeColumns(Oid relid);
+
+#endif
+
+#if PG_VERSION_NUM >= 90300
+
+/*
+ * Settings of the autoanalyze background worker.
+ */
+static char  *ifx_autoanalyze_database = NULL;
+static int    ifx_autoanalyze_naptime = 600;
+static double ifx_autoanalyze_scale_factor = 0.1;
+static int    ifx_autoanalyze_max_per_server = 1;
+
+static volatile sig_atomic_t ifx_autoanalyze_got_sigterm = false;
+static volatile sig_atomic_t ifx_autoanalyze_got_sighup = false;
+
+/*
+ * Foreign tables deferred by the autoanalyze worker
+ * (list of OIDs allocated in TopMemoryContext).
+ */
+static List *ifx_autoanalyze_pending = NIL;
+
+extern void ifxAutoAnalyzeMain(Datum main_arg);
+static void ifxAutoAnalyzeInit(void);
+
+#endif
+
 /*******************************************************************************
  * FDW callback routines.
  */
@@ -305,7 +600,11 @@ static ForeignScan *ifxGetForeignPlan(PlannerInfo *root,
 									  Oid foreignTableId,
 									  ForeignPath *best_path,
 									  List *tlist,
-									  List *scan_clauses);
+									  List *scan_clauses
+#if PG_VERSION_NUM >= 90500
+									  , Plan *outer_plan
+#endif
+	);
 
 static int
 ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
@@ -315,6 +614,116 @@ static bool
 ifxAnalyzeForeignTable(Relation relation, AcquireSampleRowsFunc *func,
 					   BlockNumber *totalpages);
 
+static List *ifxGetUsefulPathkeys(PlannerInfo *root,
+								  RelOptInfo *baserel);
+
+static void ifxRegenerateScanQuery(IfxFdwPlanState *planState);
+
+static void ifxAddForeignPath(PlannerInfo *root,
+							  RelOptInfo  *baserel,
+							  List        *pathkeys,
+							  char        *sort_clause,
+							  int          limit_count,
+							  Cost         startup_cost,
+							  Cost         total_cost);
+
+static int ifxGetLimitForPushdown(PlannerInfo *root,
+								  RelOptInfo *baserel,
+								  IfxFdwPlanState *planState);
+
+static void ifxGetForeignIndexes(RelOptInfo *baserel,
+								 IfxFdwPlanState *planState);
+static void ifxGetForeignFragments(RelOptInfo *baserel,
+								   IfxFdwPlanState *planState);
+
+static Bitmapset *ifxEqualityAttnums(List *clauses, Index relid);
+
+static IfxIndexDef *ifxMatchIndex(IfxFdwPlanState *planState,
+								  Bitmapset *eq_attnums);
+
+#if PG_VERSION_NUM >= 90300
+
+static void ifxAddForeignParamPaths(PlannerInfo *root,
+									RelOptInfo *baserel,
+									IfxFdwPlanState *planState);
+
+static bool ifxEcMemberMatchesForeign(PlannerInfo *root,
+									  RelOptInfo *rel,
+									  EquivalenceClass *ec,
+									  EquivalenceMember *em,
+									  void *arg);
+
+static void ifxPushdownParamJoinClauses(IfxFdwPlanState *planState,
+										RelOptInfo *baserel,
+										List *join_clauses,
+										List **pushed_clauses,
+										List **param_exprs);
+
+static bool ifxIndexCoversJoinColumn(IfxIndexDef *index,
+									 Bitmapset *eq_attnums,
+									 Bitmapset *join_attnums);
+
+static bool ifxContainsExecParam(Node *node, void *context);
+
+#endif
+
+static bool ifxHasLocalQuals(RelOptInfo *baserel,
+							 IfxFdwPlanState *planState);
+
+#if PG_VERSION_NUM >= 90600
+
+static void ifxGetForeignUpperPaths(PlannerInfo *root,
+									UpperRelationKind stage,
+									RelOptInfo *input_rel,
+									RelOptInfo *output_rel
+#if PG_VERSION_NUM >= 110000
+									, void *extra
+#endif
+	);
+
+static List *ifxGetUpperRelInfos(RelOptInfo *input_rel,
+								 IfxFdwPlanState *inputState);
+static void ifxAppendUpperFromClause(StringInfo buf,
+									 IfxFdwPlanState *inputState);
+static IfxFdwPlanState *ifxCopyUpperPlanState(IfxFdwPlanState *inputState,
+											  char *query,
+											  List *tlist);
+
+static void ifxAddForeignGroupingPath(PlannerInfo *root,
+									  RelOptInfo *input_rel,
+									  RelOptInfo *grouped_rel);
+
+static void ifxAddForeignDistinctPath(PlannerInfo *root,
+									  RelOptInfo *input_rel,
+									  RelOptInfo *distinct_rel);
+
+static bool ifxPlanDirectModify(PlannerInfo *root,
+								ModifyTable *plan,
+								Index resultRelation,
+								int subplan_index);
+static void ifxBeginDirectModify(ForeignScanState *node, int eflags);
+static TupleTableSlot *ifxIterateDirectModify(ForeignScanState *node);
+static void ifxEndDirectModify(ForeignScanState *node);
+static void ifxExplainDirectModify(ForeignScanState *node,
+								   ExplainState *es);
+
+#endif
+
+#if PG_VERSION_NUM >= 90500
+
+static void ifxGetForeignJoinPaths(PlannerInfo *root,
+								   RelOptInfo *joinrel,
+								   RelOptInfo *outerrel,
+								   RelOptInfo *innerrel,
+								   JoinType jointype,
+								   JoinPathExtraData *extra);
+
+static ForeignScan *ifxGetForeignRemotePlan(PlannerInfo *root,
+											RelOptInfo *rel,
+											List *tlist);
+
+#endif
+
 #else
 
 static FdwPlan *ifxPlanForeignScan(Oid foreignTableOid,
@@ -351,17 +760,120 @@ ifxCloseConnection(PG_FUNCTION_ARGS);
  * Implementation starts here
  */
 
+/*
+ * Returns the identifier of the remote column the specified
+ * attribute of a foreign table is mapped to. This is the value
+ * of the column_name option, if specified, or the name of the
+ * local column otherwise.
+ */
+char *ifxGetRemoteColumnName(Oid foreignTableOid, AttrNumber attnum)
+{
+#if PG_VERSION_NUM >= 90200
+	List     *col_options;
+	ListCell *cell;
+
+	col_options = GetForeignColumnOptions(foreignTableOid, attnum);
+	foreach(cell, col_options)
+	{
+		DefElem *def = (DefElem *) lfirst(cell);
+
+		if (strcmp(def->defname, "column_name") == 0)
+			return defGetString(def);
+	}
+#endif
+
+	return get_relid_attribute_name(foreignTableOid, attnum);
+}
+
+/*
+ * Returns the first field of the qualifier of the remote INTERVAL
+ * column the specified attribute is mapped to, see
+ * ifxGetIntervalQualifierStart(). Returns -1 in case it can't be
+ * determined, e.g. for foreign tables based on a query. Must be called
+ * with the connection of the foreign table being the current one.
+ */
+int ifxGetRemoteIntervalStart(Oid foreignTableOid, AttrNumber attnum)
+{
+	ForeignTable *foreignTable = GetForeignTable(foreignTableOid);
+	ListCell     *cell;
+
+	foreach(cell, foreignTable->options)
+	{
+		DefElem *def = (DefElem *) lfirst(cell);
+
+		if (strcmp(def->defname, "table") == 0)
+			return ifxGetIntervalQualifierStart(defGetString(def),
+												ifxGetRemoteColumnName(foreignTableOid,
+																	   attnum));
+	}
+
+	return -1;
+}
+
+/*
+ * Returns a comma separated list of the remote column identifiers
+ * of the specified foreign table, in the order of the local column
+ * definition. Dropped columns are skipped, so the position of each
+ * identifier matches the column mapping done by ifxPgColumnData().
+ *
+ * Returns NULL in case no column of the foreign table carries a
+ * column_name option, the caller can safely select all remote
+ * columns then.
+ *
+ * If attrs is specified, only the columns with the attribute
+ * numbers contained in attrs are listed. The list is returned
+ * regardless of any column_name options then.
+ */
+static char *ifxGetRemoteColumnList(Oid foreignTableOid,
+									Bitmapset *attrs)
+{
+	Relation        foreignRel;
+	TupleDesc       tupdesc;
+	StringInfoData  buf;
+	bool            has_column_name = false;
+	int             i;
+
+	initStringInfo(&buf);
+
+	/* open foreign table, should be locked already */
+	foreignRel = heap_open(foreignTableOid, NoLock);
+	tupdesc    = RelationGetDescr(foreignRel);
+
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		char             *colname;
+
+		if (attr->attisdropped)
+			continue;
+
+		if ((attrs != NULL) && !bms_is_member(attr->attnum, attrs))
+			continue;
+
+		colname = ifxGetRemoteColumnName(foreignTableOid, attr->attnum);
+
+		if (strcmp(colname, NameStr(attr->attname)) != 0)
+			has_column_name = true;
+
+		appendStringInfo(&buf, "%s%s",
+						 (buf.len > 0) ? ", " : "",
+						 colname);
+	}
+
+	heap_close(foreignRel, NoLock);
+
+	return (has_column_name || (attrs != NULL)) ? buf.data : NULL;
+}
+
 #if PG_VERSION_NUM >= 90300
 
 /*
- * Set the given ROWID into the Informix
- * SQLDA structure.
+ * Extracts the Informix ROWID of the current tuple
+ * from its resjunk column.
  */
-static void ifxRowIdValueToSqlda(IfxFdwExecutionState *state,
-								 int                   paramId,
-								 TupleTableSlot       *planSlot)
+static int ifxGetJunkRowId(IfxFdwExecutionState *state,
+						   TupleTableSlot       *planSlot)
 {
-	int   rowid;
 	ItemPointer iptr;
 	bool  isnull;
 
@@ -384,7 +896,18 @@ static void ifxRowIdValueToSqlda(IfxFdwExecutionState *state,
 	 * since it will fail the Assertion for a given OffsetNumber
 	 * otherwise.
 	 */
-	rowid = (int) ((iptr->ip_blkid.bi_hi << 16) | ((uint16) iptr->ip_blkid.bi_lo));
+	return (int) ((iptr->ip_blkid.bi_hi << 16) | ((uint16) iptr->ip_blkid.bi_lo));
+}
+
+/*
+ * Assigns the ROWID of the current tuple to the
+ * specified parameter of the SQLDA structure.
+ */
+static void ifxRowIdValueToSqlda(IfxFdwExecutionState *state,
+								 int                   paramId,
+								 TupleTableSlot       *planSlot)
+{
+	int rowid = ifxGetJunkRowId(state, planSlot);
 
 	/*
 	 * Mark the value valid, otherwise the conversion routine
@@ -420,10 +943,7 @@ ifxExplainForeignModify(ModifyTableState *mstate,
 		ifxDeserializeFdwData(&state, fdw_private);
 
 		/* Give some possibly useful info about the remote query used */
-		if (es->costs)
-		{
-			ExplainPropertyText("Informix query", state.stmt_info.query, es);
-		}
+		ExplainPropertyText("Informix query", state.stmt_info.query, es);
 	}
 }
 
@@ -496,6 +1016,11 @@ static IfxFdwExecutionState *ifxCopyExecutionState(IfxFdwExecutionState *state)
 	 */
 	copy->use_rowid = state->use_rowid;
 
+	/*
+	 * The foreign table doesn't change either.
+	 */
+	copy->foreignTableOid = state->foreignTableOid;
+
 	/*
 	 * ...and we're done.
 	 */
@@ -638,10 +1163,7 @@ static void ifxColumnValuesToSqlda(IfxFdwExecutionState *state,
  */
 char *dispatchColumnIdentifier(int varno, int varattno, PlannerInfo *root)
 {
-	char          *ident = NULL;
 	RangeTblEntry *rte;
-	List          *col_options;
-	ListCell      *cell;
 
 	/*
 	 * Take take for special varnos!
@@ -651,32 +1173,10 @@ char *dispatchColumnIdentifier(int varno, int varattno, PlannerInfo *root)
 	rte = planner_rt_fetch(varno, root);
 
 	/*
-	 * Check out if this varattno has a special
-	 * column_name value attached.
-	 *
-	 * TODO: SELECT statements currently don't honor ifx_column_name settings,
-	 *       this issue will be adressed in the very near future!
-	 */
-	col_options = GetForeignColumnOptions(rte->relid, varattno);
-	foreach(cell, col_options)
-	{
-		DefElem *def = (DefElem *) lfirst(cell);
-
-		if (strcmp(def->defname, "ifx_column_name") == 0)
-		{
-			ident = defGetString(def);
-			break; /* we're done */
-		}
-	}
-
-	/*
-	 * Rely on the local column identifier if no ifx_column_name
-	 * was found.
+	 * Rely on the local column identifier if no column_name
+	 * option was specified for this column.
 	 */
-	if (ident == NULL)
-		ident = get_relid_attribute_name(rte->relid, varattno);
-
-	return ident;
+	return ifxGetRemoteColumnName(rte->relid, varattno);
 }
 
 /*
@@ -857,6 +1357,27 @@ ifxPlanForeignModify(PlannerInfo *root,
 	 */
 	ifxPrepareParamsForModify(state, root, resultRelation, plan, rte->relid);
 
+	/*
+	 * Rows of a modify action can be sent in batches (batch_size
+	 * option). A batched UPDATE or DELETE identifies its rows by
+	 * their ROWIDs and defers the remote statement, so it can't be
+	 * used with RETURNING or AFTER EACH ROW triggers. An UPDATE
+	 * is only batched if all rows get the same new values. The
+	 * ROWID list is limited to IFX_MAX_ROWID_BATCH entries.
+	 */
+	if (operation == CMD_INSERT)
+	{
+		state->batch_size = coninfo->batch_size;
+	}
+	else if (state->use_rowid
+			 && (plan->returningLists == NIL)
+			 && !ifxCheckForAfterRowTriggers(rte->relid, state, operation)
+			 && ((operation == CMD_DELETE)
+				 || ifxModifyValuesRowInvariant(state, plan, subplan_index)))
+	{
+		state->batch_size = Min(coninfo->batch_size, IFX_MAX_ROWID_BATCH);
+	}
+
 	/*
 	 * Generate the query.
 	 */
@@ -1030,8 +1551,8 @@ ifxBeginForeignModify(ModifyTableState *mstate,
 		/*
 		 * Get column list for local table definition.
 		 *
-		 * XXX: Modify on a foreign Informix table relies on equally
-		 *      named column identifiers.
+		 * NOTE: Modify on a foreign Informix table relies on the
+		 *       remote column identifiers, see dispatchColumnIdentifier().
 		 */
 		ifxPgColumnData(foreignTableOid, state);
 
@@ -1063,21 +1584,12 @@ ifxBeginForeignModify(ModifyTableState *mstate,
 			 state->stmt_info.ifxAttrCount);
 
 		/*
-		 * Don't forget to open the INSERT cursor we have established
-		 * ealier in the planning phase. UPDATE, the only other command
-		 * type possible here, relies on the cursor from it's scanning
-		 * part, so no need to do the same for it.
+		 * With batch_size, rows are sent to the server in batches,
+		 * see ifxPlanForeignModify().
 		 */
-		if (mstate->operation == CMD_INSERT)
-		{
-			/*
-			 * Open the associated cursor...
-			 */
-			elog(DEBUG1, "open cursor with query \"%s\"",
-				 state->stmt_info.query);
-			ifxOpenCursorForPrepared(&state->stmt_info);
-			ifxCatchExceptions(&state->stmt_info, IFX_STACK_OPEN);
-		}
+		if (state->batch_size > 0)
+			elog(DEBUG1, "informix_fdw: modify batch size %d",
+				 state->batch_size);
 
 		state->stmt_info.ifxAttrDefs = palloc(state->stmt_info.ifxAttrCount
 											  * sizeof(IfxAttrDef));
@@ -1113,21 +1625,55 @@ ifxBeginForeignModify(ModifyTableState *mstate,
 		 * Assign sqlvar pointers to the allocated memory area.
 		 */
 		ifxSetupDataBufferAligned(&state->stmt_info);
-	}
-}
 
-static TupleTableSlot *
-ifxExecForeignInsert(EState *estate,
-					 ResultRelInfo *rinfo,
-					 TupleTableSlot *slot,
-					 TupleTableSlot *planSlot)
-{
-	IfxFdwExecutionState *state;
-	int                   attnum;
+		/*
+		 * Don't forget to open the INSERT cursor we have established
+		 * ealier in the planning phase. UPDATE, the only other command
+		 * type possible here, relies on the cursor from it's scanning
+		 * part, so no need to do the same for it.
+		 */
+		if (mstate->operation == CMD_INSERT)
+		{
+			int buffer_size = 0;
 
-	/*
-	 * Setup action...
-	 */
+			/*
+			 * A batched INSERT sizes the insert buffer of the cursor
+			 * to hold batch_size rows, the cursor sends them to the
+			 * server as soon as the buffer is full. The buffer size
+			 * is taken at OPEN, restore the former one afterwards.
+			 */
+			if (state->batch_size > 0)
+				buffer_size = ifxSetInsertBufferSize((int) Min((size_t) state->batch_size
+															   * state->stmt_info.row_size,
+															   (size_t) INT_MAX));
+
+			/*
+			 * Open the associated cursor...
+			 */
+			elog(DEBUG1, "open cursor with query \"%s\"",
+				 state->stmt_info.query);
+			ifxOpenCursorForPrepared(&state->stmt_info);
+
+			if (state->batch_size > 0)
+				ifxSetInsertBufferSize(buffer_size);
+
+			ifxCatchExceptions(&state->stmt_info, IFX_STACK_OPEN);
+		}
+	}
+}
+
+static TupleTableSlot *
+ifxExecForeignInsert(EState *estate,
+					 ResultRelInfo *rinfo,
+					 TupleTableSlot *slot,
+					 TupleTableSlot *planSlot)
+{
+	IfxFdwExecutionState *state;
+	int                   attnum;
+
+	/*
+	 * Setup action...
+	 */
 	state = rinfo->ri_FdwState;
 	elog(DEBUG3, "informix_fdw: exec insert with cursor \"%s\"",
 		 state->stmt_info.cursor_name);
@@ -1165,7 +1711,22 @@ ifxExecForeignInsert(EState *estate,
 	 * here via PUT...
 	 */
 	ifxPutValuesInPrepared(&state->stmt_info);
-	ifxCatchExceptions(&state->stmt_info, 0);
+
+	if (state->batch_size > 0)
+	{
+		/*
+		 * The row is buffered by the INSERT cursor, which sends
+		 * its buffered rows to the server as soon as the insert
+		 * buffer sized for batch_size rows is full. The remaining
+		 * rows are flushed by ifxEndForeignModify().
+		 */
+		state->batch_rows++;
+		ifxCheckInsertBatch(state, false);
+	}
+	else
+	{
+		ifxCatchExceptions(&state->stmt_info, 0);
+	}
 
 	return slot;
 }
@@ -1210,6 +1771,14 @@ ifxExecForeignDelete(EState *estate,
 		 */
 		ifxCatchExceptions(&state->stmt_info, 0);
 	}
+	else if (state->batch_size > 0)
+	{
+		/*
+		 * Batched DELETE, the statement is executed as soon
+		 * as the batch is full.
+		 */
+		ifxModifyBatchAddRow(state, planSlot);
+	}
 	else
 	{
 		/*
@@ -1256,15 +1825,36 @@ ifxExecForeignUpdate(EState *estate,
 	 * We also need to track the parameter id to
 	 * reference the correct sqlvar struct array
 	 * member in our SQLDA structure.
+	 *
+	 * A batched UPDATE collects rows with the same new
+	 * column values only, so the current batch is sent
+	 * first if the values differ.
 	 */
-	param_id = 0;
-	foreach(cell, state->affectedAttrNums)
+	if ((state->batch_size > 0)
+		&& (state->batch_rows > 0)
+		&& !ifxModifyBatchValuesEqual(state, slot))
+		ifxFlushModifyBatch(state);
+
+	if (state->batch_rows == 0)
 	{
-		int attnum = lfirst_int(cell);
+		param_id = 0;
+		foreach(cell, state->affectedAttrNums)
+		{
+			int attnum = lfirst_int(cell);
+
+			state->pgAttrDefs[attnum - 1].param_id = param_id;
+			ifxColumnValuesToSqlda(state, slot, attnum - 1);
+			param_id++;
+		}
 
-		state->pgAttrDefs[attnum - 1].param_id = param_id;
-		ifxColumnValuesToSqlda(state, slot, attnum - 1);
-		param_id++;
+		if (state->batch_size > 0)
+			ifxModifyBatchSaveValues(state, slot);
+	}
+
+	if (state->batch_size > 0)
+	{
+		ifxModifyBatchAddRow(state, planSlot);
+		return slot;
 	}
 
 	/*
@@ -1312,7 +1902,22 @@ static void ifxEndForeignModify(EState *estate,
 	if ((state->stmt_info.cursorUsage == IFX_INSERT_CURSOR)
 		&& (state->stmt_info.call_stack & IFX_STACK_OPEN))
 	{
-		ifxFlushCursor(&state->stmt_info);
+		/*
+		 * A batched INSERT flushes the pending rows of the
+		 * last batch and checks them.
+		 */
+		if (state->batch_size > 0)
+			ifxCheckInsertBatch(state, true);
+		else
+			ifxFlushCursor(&state->stmt_info);
+	}
+	else if (state->batch_size > 0)
+	{
+		/*
+		 * Execute the UPDATE or DELETE for the rows of the
+		 * last batch.
+		 */
+		ifxFlushModifyBatch(state);
 	}
 
 	/*
@@ -1327,6 +1932,222 @@ static void ifxEndForeignModify(EState *estate,
 	ifxRewindCallstack(&state->stmt_info);
 }
 
+/*
+ * Failing row of a batched INSERT, passed to
+ * ifxInsertBatchErrorCallback().
+ */
+typedef struct IfxInsertBatchError
+{
+	int  offset; /* offset of the failing row within the batch */
+	int  nrows;  /* number of rows in the batch */
+	long start;  /* number of rows sent by former batches */
+} IfxInsertBatchError;
+
+/*
+ * Adds the failing row of a batched INSERT to the
+ * error context.
+ */
+static void ifxInsertBatchErrorCallback(void *arg)
+{
+	IfxInsertBatchError *batch_error = (IfxInsertBatchError *) arg;
+
+	errcontext("row %d of INSERT batch with %d rows (row %ld of the INSERT)",
+			   batch_error->offset, batch_error->nrows,
+			   batch_error->start + batch_error->offset);
+}
+
+/*
+ * Checks the result of the last PUT or, if flush is true, flushes
+ * the INSERT cursor and checks its result. The batch consists of
+ * the rows pending since the cursor sent rows to the server the
+ * last time, either implicitly by PUT or by a flush. In case of an
+ * error, the failing row is reported by its offset within the batch.
+ */
+static void ifxCheckInsertBatch(IfxFdwExecutionState *state, bool flush)
+{
+	int nrows_sent;
+
+	if (flush)
+		ifxFlushCursor(&state->stmt_info);
+
+	/*
+	 * sqlerrd[2] holds the number of rows the PUT or FLUSH has
+	 * inserted on the server, that is the number of rows before
+	 * the failing one in case of an error.
+	 */
+	nrows_sent = ifxGetSQLCAErrd(SQLCA_NROWS_AFFECTED);
+
+	if (ifxGetSqlCode() < 0)
+	{
+		IfxInsertBatchError  batch_error;
+		ErrorContextCallback errcallback;
+
+		/*
+		 * Save the position of the failing row now,
+		 * ifxCatchExceptions() rewinds the callstack before
+		 * the error message is built.
+		 */
+		batch_error.nrows  = state->batch_rows;
+		batch_error.start  = state->batch_start;
+		batch_error.offset = nrows_sent + 1;
+
+		if (batch_error.offset > batch_error.nrows)
+			batch_error.offset = batch_error.nrows;
+
+		errcallback.callback = ifxInsertBatchErrorCallback;
+		errcallback.arg      = (void *) &batch_error;
+		errcallback.previous = error_context_stack;
+		error_context_stack  = &errcallback;
+
+		ifxCatchExceptions(&state->stmt_info, 0);
+
+		error_context_stack = errcallback.previous;
+	}
+	else
+	{
+		/*
+		 * A flush sends all pending rows, PUT only the ones of
+		 * a full insert buffer, if any. The remaining rows
+		 * start a new batch.
+		 */
+		if (flush || (nrows_sent > state->batch_rows))
+			nrows_sent = state->batch_rows;
+
+		if (nrows_sent > 0)
+		{
+			state->batch_start += nrows_sent;
+			state->batch_rows  -= nrows_sent;
+		}
+	}
+}
+
+/*
+ * Adds the current row to the batch of a batched UPDATE or DELETE.
+ * Its ROWID is bound to the next placeholder of the ROWID list
+ * following the new column values, see ifxGenerateDeleteSql().
+ * The statement is executed as soon as the batch is full.
+ */
+static void ifxModifyBatchAddRow(IfxFdwExecutionState *state,
+								 TupleTableSlot *planSlot)
+{
+	int paramId;
+	int rowid;
+
+	paramId = state->stmt_info.ifxAttrCount - state->batch_size
+		+ state->batch_rows;
+	rowid   = ifxGetJunkRowId(state, planSlot);
+
+	state->stmt_info.ifxAttrDefs[paramId].indicator = INDICATOR_NOT_NULL;
+	ifxSetInteger(&(state->stmt_info), paramId, rowid);
+
+	if (state->batch_rows == 0)
+		state->batch_first_rowid = rowid;
+
+	state->batch_rows++;
+
+	if (state->batch_rows >= state->batch_size)
+		ifxFlushModifyBatch(state);
+}
+
+/*
+ * Executes the UPDATE or DELETE for the rows collected in the
+ * current batch, if any. Placeholders not used by a partial batch
+ * repeat its first ROWID, which doesn't change the result.
+ */
+static void ifxFlushModifyBatch(IfxFdwExecutionState *state)
+{
+	int paramId;
+
+	if (state->batch_rows == 0)
+		return;
+
+	for (paramId = state->stmt_info.ifxAttrCount - state->batch_size
+			 + state->batch_rows;
+		 paramId < state->stmt_info.ifxAttrCount;
+		 paramId++)
+	{
+		state->stmt_info.ifxAttrDefs[paramId].indicator = INDICATOR_NOT_NULL;
+		ifxSetInteger(&(state->stmt_info), paramId,
+					  state->batch_first_rowid);
+	}
+
+	elog(DEBUG2, "informix_fdw: execute modify batch with %d rows",
+		 state->batch_rows);
+
+	ifxExecuteStmtSqlda(&state->stmt_info);
+	ifxCatchExceptions(&state->stmt_info, 0);
+
+	state->batch_start += state->batch_rows;
+	state->batch_rows   = 0;
+}
+
+/*
+ * Returns true in case the new column values of the specified
+ * tuple match the ones of the current UPDATE batch.
+ */
+static bool ifxModifyBatchValuesEqual(IfxFdwExecutionState *state,
+									  TupleTableSlot *slot)
+{
+	ListCell *cell;
+
+	slot_getallattrs(slot);
+
+	foreach(cell, state->affectedAttrNums)
+	{
+		int               attnum = lfirst_int(cell);
+		Form_pg_attribute attr   = TupleDescAttr(slot->tts_tupleDescriptor,
+												 attnum - 1);
+
+		if (slot->tts_isnull[attnum - 1] != state->batch_nulls[attnum - 1])
+			return false;
+
+		if (!slot->tts_isnull[attnum - 1]
+			&& !datumIsEqual(slot->tts_values[attnum - 1],
+							 state->batch_values[attnum - 1],
+							 attr->attbyval, attr->attlen))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Saves the new column values of the specified tuple, which
+ * are shared by all rows of the current UPDATE batch.
+ */
+static void ifxModifyBatchSaveValues(IfxFdwExecutionState *state,
+									 TupleTableSlot *slot)
+{
+	ListCell *cell;
+
+	slot_getallattrs(slot);
+
+	if (state->batch_values == NULL)
+	{
+		state->batch_values = (Datum *) palloc0(sizeof(Datum) * state->pgAttrCount);
+		state->batch_nulls  = (bool *) palloc0(sizeof(bool) * state->pgAttrCount);
+	}
+
+	foreach(cell, state->affectedAttrNums)
+	{
+		int               attnum = lfirst_int(cell);
+		Form_pg_attribute attr   = TupleDescAttr(slot->tts_tupleDescriptor,
+												 attnum - 1);
+
+		/* release the copy of the former batch */
+		if (!attr->attbyval
+			&& !state->batch_nulls[attnum - 1]
+			&& (state->batch_values[attnum - 1] != (Datum) 0))
+			pfree(DatumGetPointer(state->batch_values[attnum - 1]));
+
+		state->batch_nulls[attnum - 1]  = slot->tts_isnull[attnum - 1];
+		state->batch_values[attnum - 1] = (slot->tts_isnull[attnum - 1])
+			? (Datum) 0
+			: datumCopy(slot->tts_values[attnum - 1],
+						attr->attbyval, attr->attlen);
+	}
+}
+
 /*
  * Prepare parameters for modify action.
  */
@@ -1425,100 +2246,411 @@ static void ifxPrepareParamsForModify(IfxFdwExecutionState *state,
 	heap_close(rel, NoLock);
 }
 
-#endif
-
 /*
- * Check the specified foreign table OID if it has
- * AFTER EACH ROW triggers attached. ifxCheckForAfterRowTriggers()
- * assumes, that the caller already locked foreignTableOid for
- * inspection.
+ * Returns true in case the new column values of an UPDATE don't
+ * depend on the updated row, e.g. SET status = 'X'. Column
+ * references and volatile functions make them row dependent.
  */
-static bool ifxCheckForAfterRowTriggers(Oid foreignTableOid,
-										IfxFdwExecutionState *state,
-										CmdType cmd)
+static bool ifxModifyValuesRowInvariant(IfxFdwExecutionState *state,
+										ModifyTable          *plan,
+										int                   subplan_index)
 {
-	Relation rel    = heap_open(foreignTableOid, NoLock);
-	bool     result = false;
+	Plan     *subplan = (Plan *) list_nth(plan->plans, subplan_index);
+	ListCell *cell;
 
-	/*
-	 * We are interested in after triggers only.
-	 */
-	if (rel->trigdesc)
+	foreach(cell, state->affectedAttrNums)
 	{
-		switch (cmd) {
-			case CMD_INSERT:
-				result = (rel->trigdesc->trig_insert_after_row);
-				break;
-			case CMD_DELETE:
-				result = (rel->trigdesc->trig_delete_after_row);
-				break;
-			case CMD_UPDATE:
-				result = (rel->trigdesc->trig_update_after_row);
-				break;
-			default:
-				result = false;
-				break;
-		}
-	}
+		TargetEntry *tle = get_tle_by_resno(subplan->targetlist,
+											lfirst_int(cell));
 
-	heap_close(rel, NoLock);
+		if ((tle == NULL)
+			|| contain_var_clause((Node *) tle->expr)
+			|| contain_volatile_functions((Node *) tle->expr))
+			return false;
+	}
 
-	return result;
+	return true;
 }
 
+#endif
+
+#if PG_VERSION_NUM >= 90600
+
 /*
- * Extract the Informix ROWID from the current
- * tuple. The ROWID is encoded within a PostgreSQL ItemPointer
- * and returned to the caller.
+ * ifxPlanDirectModify
  *
- * Returns NULL in case no ROWID could be extracted.
+ * Checks wether an UPDATE or DELETE can be executed as a single
+ * statement on the Informix server. This requires the modified
+ * foreign table to be scanned by a plain foreign scan with all
+ * restriction clauses pushed down and all new column values
+ * shippable to Informix. RETURNING isn't supported.
+ *
+ * If possible, the remote statement is generated and the foreign
+ * scan is turned into a direct modify node.
  */
-static ItemPointer ifxGetRowIdForTuple(IfxFdwExecutionState *state)
+static bool ifxPlanDirectModify(PlannerInfo *root,
+								ModifyTable *plan,
+								Index resultRelation,
+								int subplan_index)
 {
-	ItemPointer rowid;
-	bool        isnull;
+	CmdType            operation = plan->operation;
+	Plan              *subplan;
+	ForeignScan       *fscan;
+	RelOptInfo        *baserel;
+	IfxFdwPlanState   *planState;
+	RangeTblEntry     *rte;
+	IfxDeparseRelInfo *relinfo;
+	List              *relinfos;
+	StringInfoData     sql;
+
+	elog(DEBUG3, "informix_fdw: plan direct modify");
+
+	if ((operation != CMD_UPDATE)
+		&& (operation != CMD_DELETE))
+		return false;
 
-	/* init */
-	rowid = NULL;
+	if (plan->returningLists != NIL)
+		return false;
 
-	/* Requires disable_rowid == false! */
-	if (!state->use_rowid)
-		return rowid;
+	/*
+	 * The modified rows must be identified by the scan of the
+	 * foreign table alone, without any local filtering. Pushed down
+	 * joins (without a scan relation) and placeholders bound to
+	 * outer values or key tables (fdw_exprs) aren't supported.
+	 */
+	subplan = (Plan *) list_nth(plan->plans, subplan_index);
 
-	ifxColumnValueByAttNum(state, IFX_PGATTRCOUNT(state) - 1, &isnull);
+	if (!IsA(subplan, ForeignScan))
+		return false;
 
-	if (isnull)
-		elog(ERROR, "unexpected NULL value for Informix ROWID");
+	fscan = (ForeignScan *) subplan;
+
+	if ((fscan->scan.scanrelid != resultRelation)
+		|| (subplan->qual != NIL)
+		|| (fscan->fdw_exprs != NIL))
+		return false;
+
+	baserel   = find_base_rel(root, resultRelation);
+	planState = (IfxFdwPlanState *) baserel->fdw_private;
+
+	if ((planState == NULL)
+		|| (planState->coninfo->query != NULL)
+		|| (planState->param_exprs != NIL)
+		|| (planState->key_sets != NIL)
+		|| ifxHasLocalQuals(baserel, planState))
+		return false;
+
+	rte = planner_rt_fetch(resultRelation, root);
 
 	/*
-	 * ROWID is a 4 Byte Integer encoding the logical
-	 * page number within its first 3 bytes and the
-	 * tuple slot number within the last byte. We encode
-	 * this number into a CTID to transport the ROWID
-	 * down to the modify action.
+	 * Column references are deparsed without any table alias.
 	 */
+	relinfo = palloc(sizeof(IfxDeparseRelInfo));
+	relinfo->rtid         = resultRelation;
+	relinfo->foreignRelid = rte->relid;
+	relinfo->alias        = NULL;
+	relinfo->shippable_funcs
+		= ifxParseShippableFunctions(planState->coninfo->pushdown_functions);
+	relinfos              = list_make1(relinfo);
 
-	rowid = (ItemPointer) palloc0fast(SizeOfIptrData);
-	ItemPointerSet(rowid,
-				   DatumGetInt32(state->values[IFX_PGATTRCOUNT(state) - 1].val),
-				   0);
-	return rowid;
-}
+	initStringInfo(&sql);
 
-static HeapTuple ifxFdwMakeTuple(IfxFdwExecutionState *state,
-								 Relation              rel,
-								 ItemPointer           encoded_rowid,
-								 TupleTableSlot       *slot)
-{
-	HeapTuple tuple;
-	TupleDesc tupDesc;
+	if (operation == CMD_UPDATE)
+	{
+		Bitmapset  *tmpset = bms_copy(rte->updatedCols);
+		AttrNumber  col;
+		bool        first = true;
 
-	tupDesc  = RelationGetDescr(rel);
-	tuple    = heap_form_tuple(tupDesc, slot->tts_values, slot->tts_isnull);
+		appendStringInfo(&sql, "UPDATE %s SET ",
+						 planState->coninfo->tablename);
 
-	if (state->use_rowid)
+		/*
+		 * We transmit only the columns explicitly targeted by the
+		 * UPDATE. Their new values are found in the target list of
+		 * the scan, which matches the columns of the foreign table.
+		 */
+		while ((col = bms_first_member(tmpset)) >= 0)
+		{
+			TargetEntry *tle;
+			char        *deparsed;
+
+			col += FirstLowInvalidHeapAttributeNumber;
+
+			if (col <= InvalidAttrNumber)		/* shouldn't happen */
+				elog(ERROR, "system-column update is not supported");
+
+			tle = get_tle_by_resno(subplan->targetlist, col);
+
+			if (tle == NULL)
+				return false;
+
+			deparsed = ifxDeparseRemoteExpr((Node *) tle->expr, relinfos, NULL);
+
+			if (deparsed == NULL)
+				return false;
+
+			appendStringInfo(&sql, "%s%s = %s",
+							 first ? "" : ", ",
+							 ifxGetRemoteColumnName(rte->relid, col),
+							 deparsed);
+			first = false;
+		}
+
+		/* nothing to update, shouldn't happen */
+		if (first)
+			return false;
+	}
+	else
 	{
-		tuple->t_self = *encoded_rowid;
+		appendStringInfo(&sql, "DELETE FROM %s",
+						 planState->coninfo->tablename);
+	}
+
+	if ((planState->state->stmt_info.predicate != NULL)
+		&& (strlen(planState->state->stmt_info.predicate) > 0)
+		&& planState->coninfo->predicate_pushdown)
+	{
+		appendStringInfo(&sql, " WHERE %s",
+						 planState->state->stmt_info.predicate);
+	}
+
+	elog(DEBUG1, "informix_fdw: direct modify with query \"%s\"", sql.data);
+
+	/*
+	 * Turn the foreign scan into a direct modify node. The plan data
+	 * of the scan is kept, since the statement prepared for it during
+	 * planning needs to be released by ifxEndDirectModify().
+	 */
+	fscan->operation   = operation;
+	fscan->fdw_private = list_make3(makeString(sql.data),
+									makeInteger(plan->canSetTag),
+									fscan->fdw_private);
+
+	return true;
+}
+
+/*
+ * ifxBeginDirectModify
+ *
+ * Prepares the execution of a direct UPDATE or DELETE.
+ */
+static void ifxBeginDirectModify(ForeignScanState *node, int eflags)
+{
+	List                 *fdw_private = PG_SCANSTATE_PRIVATE_P(node);
+	IfxConnectionInfo    *coninfo;
+	IfxFdwExecutionState *state;
+	Oid                   foreignTableOid;
+
+	elog(DEBUG3, "informix_fdw: begin direct modify");
+
+	foreignTableOid = RelationGetRelid(node->ss.ss_currentRelation);
+
+	/*
+	 * Activate cached connection, this also starts a remote
+	 * transaction if required.
+	 */
+	ifxSetupConnection(&coninfo,
+					   foreignTableOid,
+					   IFX_BEGIN_SCAN,
+					   true);
+
+	state = makeIfxFdwExecutionState(-1);
+	node->fdw_state = (void *) state;
+
+	/*
+	 * Plan data of the original scan, see ifxPlanDirectModify().
+	 */
+	ifxDeserializeFdwData(state, list_nth(fdw_private,
+										  IFX_DIRECT_MODIFY_SCAN_PRIVATE));
+
+	state->stmt_info.query = strVal(list_nth(fdw_private,
+											 IFX_DIRECT_MODIFY_QUERY));
+}
+
+/*
+ * ifxIterateDirectModify
+ *
+ * Executes the direct UPDATE or DELETE on the first call. The
+ * number of affected rows is taken from the SQLCA, no rows are
+ * returned.
+ */
+static TupleTableSlot *ifxIterateDirectModify(ForeignScanState *node)
+{
+	IfxFdwExecutionState *state = (IfxFdwExecutionState *) node->fdw_state;
+	List                 *fdw_private = PG_SCANSTATE_PRIVATE_P(node);
+	EState               *estate = node->ss.ps.state;
+	Instrumentation      *instr = node->ss.ps.instrument;
+
+	elog(DEBUG3, "informix_fdw: iterate direct modify");
+
+	if (state->affected_rows < 0)
+	{
+		elog(DEBUG1, "informix_fdw: execute direct modify \"%s\"",
+			 state->stmt_info.query);
+
+		ifxExecuteImmediate(state->stmt_info.query);
+
+		/*
+		 * Save the number of affected rows before examining
+		 * exceptions, which might overwrite the SQLCA.
+		 */
+		state->affected_rows = ifxGetSQLCAErrd(SQLCA_NROWS_AFFECTED);
+		ifxCatchExceptions(&state->stmt_info, 0);
+
+		if (state->affected_rows < 0)
+			state->affected_rows = 0;
+
+		/* Increment the command es_processed count if necessary. */
+		if (intVal(list_nth(fdw_private, IFX_DIRECT_MODIFY_SET_PROCESSED)))
+			estate->es_processed += state->affected_rows;
+
+		/* ...and the tuple count for EXPLAIN ANALYZE. */
+		if (instr != NULL)
+			instr->tuplecount += state->affected_rows;
+	}
+
+	return ExecClearTuple(node->ss.ss_ScanTupleSlot);
+}
+
+/*
+ * ifxEndDirectModify
+ *
+ * Releases the resources of the original foreign scan
+ * prepared during planning.
+ */
+static void ifxEndDirectModify(ForeignScanState *node)
+{
+	IfxFdwExecutionState *state = (IfxFdwExecutionState *) node->fdw_state;
+	List                 *scan_private;
+
+	elog(DEBUG3, "informix_fdw: end direct modify");
+
+	if (state == NULL)
+		return;
+
+	ifxRewindCallstack(&state->stmt_info);
+
+	/*
+	 * Save the callstack into the cached plan, see
+	 * ifxEndForeignScan().
+	 */
+	scan_private = list_nth(PG_SCANSTATE_PRIVATE_P(node),
+							IFX_DIRECT_MODIFY_SCAN_PRIVATE);
+	ifxSetSerializedInt16Field(scan_private,
+							   SERIALIZED_CALLSTACK,
+							   state->stmt_info.call_stack);
+}
+
+/*
+ * Extra information for EXPLAIN on a direct UPDATE or DELETE.
+ */
+static void ifxExplainDirectModify(ForeignScanState *node,
+								   ExplainState *es)
+{
+	List *fdw_private = PG_SCANSTATE_PRIVATE_P(node);
+
+	if (es->verbose)
+	{
+		ExplainPropertyText("Informix query",
+							strVal(list_nth(fdw_private, IFX_DIRECT_MODIFY_QUERY)),
+							es);
+	}
+}
+
+#endif
+
+/*
+ * Check the specified foreign table OID if it has
+ * AFTER EACH ROW triggers attached. ifxCheckForAfterRowTriggers()
+ * assumes, that the caller already locked foreignTableOid for
+ * inspection.
+ */
+static bool ifxCheckForAfterRowTriggers(Oid foreignTableOid,
+										IfxFdwExecutionState *state,
+										CmdType cmd)
+{
+	Relation rel    = heap_open(foreignTableOid, NoLock);
+	bool     result = false;
+
+	/*
+	 * We are interested in after triggers only.
+	 */
+	if (rel->trigdesc)
+	{
+		switch (cmd) {
+			case CMD_INSERT:
+				result = (rel->trigdesc->trig_insert_after_row);
+				break;
+			case CMD_DELETE:
+				result = (rel->trigdesc->trig_delete_after_row);
+				break;
+			case CMD_UPDATE:
+				result = (rel->trigdesc->trig_update_after_row);
+				break;
+			default:
+				result = false;
+				break;
+		}
+	}
+
+	heap_close(rel, NoLock);
+
+	return result;
+}
+
+/*
+ * Extract the Informix ROWID from the current
+ * tuple. The ROWID is encoded within a PostgreSQL ItemPointer
+ * and returned to the caller.
+ *
+ * Returns NULL in case no ROWID could be extracted.
+ */
+static ItemPointer ifxGetRowIdForTuple(IfxFdwExecutionState *state)
+{
+	ItemPointer rowid;
+	bool        isnull;
+
+	/* init */
+	rowid = NULL;
+
+	/* Requires disable_rowid == false! */
+	if (!state->use_rowid)
+		return rowid;
+
+	ifxColumnValueByAttNum(state, IFX_PGATTRCOUNT(state) - 1, &isnull);
+
+	if (isnull)
+		elog(ERROR, "unexpected NULL value for Informix ROWID");
+
+	/*
+	 * ROWID is a 4 Byte Integer encoding the logical
+	 * page number within its first 3 bytes and the
+	 * tuple slot number within the last byte. We encode
+	 * this number into a CTID to transport the ROWID
+	 * down to the modify action.
+	 */
+
+	rowid = (ItemPointer) palloc0fast(SizeOfIptrData);
+	ItemPointerSet(rowid,
+				   DatumGetInt32(state->values[IFX_PGATTRCOUNT(state) - 1].val),
+				   0);
+	return rowid;
+}
+
+static HeapTuple ifxFdwMakeTuple(IfxFdwExecutionState *state,
+								 Relation              rel,
+								 ItemPointer           encoded_rowid,
+								 TupleTableSlot       *slot)
+{
+	HeapTuple tuple;
+	TupleDesc tupDesc;
+
+	tupDesc  = RelationGetDescr(rel);
+	tuple    = heap_form_tuple(tupDesc, slot->tts_values, slot->tts_isnull);
+
+	if (state->use_rowid)
+	{
+		tuple->t_self = *encoded_rowid;
 	}
 
 	return tuple;
@@ -1635,8 +2767,9 @@ ifxGetValuesFromTuple(IfxFdwExecutionState *state,
  *
  * If the specified IfxFdwExecutionState was prepared with a
  * ReScan event, ifxFetchTuple() will set the cursor to
- * the first tuple, in case the current cursor is SCROLLable.
- * If not, the cursor is reopened for a rescan.
+ * the first tuple, in case the current cursor is SCROLLable
+ * and has no placeholders. If not, the cursor is reopened for
+ * a rescan.
  */
 static IfxSqlStateClass
 ifxFetchTuple(IfxFdwExecutionState *state)
@@ -1647,16 +2780,26 @@ ifxFetchTuple(IfxFdwExecutionState *state)
 	 */
 	if (state->rescan)
 	{
-		if (state->stmt_info.cursorUsage == IFX_SCROLL_CURSOR)
+		/*
+		 * A cursor with placeholders is always reopened, since
+		 * their values might have changed, see ifxReScanForeignScan().
+		 */
+		if ((state->stmt_info.cursorUsage == IFX_SCROLL_CURSOR)
+			&& (state->param_count == 0))
 			ifxFetchFirstRowFromCursor(&state->stmt_info);
 		else
 		{
 			elog(DEBUG3, "re-opening informix cursor in rescan state");
-			ifxCloseCursor(&state->stmt_info);
-			ifxCatchExceptions(&state->stmt_info, 0);
 
-			ifxOpenCursorForPrepared(&state->stmt_info);
-			ifxCatchExceptions(&state->stmt_info, 0);
+			/* not opened yet by ifxBeginForeignScan() */
+			if ((state->stmt_info.call_stack & IFX_STACK_OPEN) == IFX_STACK_OPEN)
+			{
+				ifxCloseCursor(&state->stmt_info);
+				ifxCatchExceptions(&state->stmt_info, 0);
+			}
+
+			ifxOpenScanCursor(state);
+			ifxCatchExceptions(&state->stmt_info, IFX_STACK_OPEN);
 
 			ifxFetchRowFromCursor(&state->stmt_info);
 		}
@@ -1677,76 +2820,324 @@ ifxFetchTuple(IfxFdwExecutionState *state)
 }
 
 /*
- * Entry point for scan preparation. Does all the leg work
- * for preparing the query and cursor definitions before
- * entering the executor.
+ * Opens the cursor of the specified scan state, binding
+ * the values of the placeholders in the remote query, if any.
  */
-static void ifxPrepareScan(IfxConnectionInfo *coninfo,
-						   IfxFdwExecutionState *state)
+static void ifxOpenScanCursor(IfxFdwExecutionState *state)
 {
-	/*
-	 * Prepare parameters of the state structure
-	 * for scan later.
-	 */
-	ifxPrepareParamsForScan(state, coninfo);
+	if (state->param_count == 0)
+	{
+		ifxOpenCursorForPrepared(&state->stmt_info);
+		return;
+	}
 
-	/* Finally do the cursor preparation */
-	ifxPrepareCursorForScan(&state->stmt_info, coninfo);
+	if (ifxOpenCursorForPreparedParams(&state->stmt_info,
+									   state->param_count,
+									   state->param_values) < 0)
+	{
+		ifxRewindCallstack(&state->stmt_info);
+		ereport(ERROR, (errcode(ERRCODE_FDW_OUT_OF_MEMORY),
+						errmsg("could not allocate informix descriptor area for parameters")));
+	}
 }
 
+#if PG_VERSION_NUM >= 90200
+
 /*
- * Guts of connection establishing.
- *
- * Creates a new cached connection handle if not already cached
- * and sets the connection current. If already cached, make the
- * cached handle current, too.
- *
- * Returns the cached connection handle (either newly created or already
- * cached).
+ * Evaluates the expressions bound to the placeholders of the
+ * remote query. The values are reused when the cursor is reopened
+ * during a rescan, unless they depend on executor parameters of
+ * an outer relation, see ifxReScanForeignScan().
  */
-static IfxCachedConnection * ifxSetupConnection(IfxConnectionInfo **coninfo,
-												Oid foreignTableOid,
-												IfxForeignScanMode mode,
-												bool error_ok)
+static void ifxEvalParamExprs(IfxFdwExecutionState *state,
+							  ForeignScanState *node)
 {
-	IfxCachedConnection *cached_handle;
-	bool                 conn_cached;
-	IfxSqlStateClass     err;
+	ExprContext   *econtext = node->ss.ps.ps_ExprContext;
+	MemoryContext  oldcontext;
+	ListCell      *cell;
+	int            i;
 
-	/*
-	 * If not already done, initialize cache data structures.
-	 */
-	InformixCacheInit();
+	if (state->param_values == NULL)
+		state->param_values = (char **) palloc0(sizeof(char *) * state->param_count);
+
+	/* release values of a former evaluation */
+	for (i = 0; i < state->param_count; i++)
+	{
+		if (state->param_values[i] != NULL)
+		{
+			pfree(state->param_values[i]);
+			state->param_values[i] = NULL;
+		}
+	}
 
 	/*
-	 * Initialize connection structures and retrieve FDW options
+	 * Evaluate in the per-tuple memory context, but keep the
+	 * converted values in our own context.
 	 */
+	oldcontext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
 
-	*coninfo = ifxMakeConnectionInfo(foreignTableOid);
-	elog(DEBUG1, "informix connection dsn \"%s\"", (*coninfo)->dsn);
+	i = 0;
+	foreach(cell, state->param_exprs)
+	{
+		ExprState *exprstate = (ExprState *) lfirst(cell);
+		Datum      value;
+		bool       isnull;
 
-	/*
-	 * Set requested scan mode.
-	 */
-	(*coninfo)->scan_mode = mode;
+		value = IFX_EXEC_EVAL_EXPR(exprstate, econtext, &isnull);
 
-	/*
-	 * Lookup the connection name in the connection cache.
-	 */
-	cached_handle = ifxConnCache_add(foreignTableOid, *coninfo, &conn_cached);
+		if (!isnull)
+		{
+			char *strval = ifxParamValueToString(value,
+												 exprType((Node *) exprstate->expr));
 
-	/*
-	 * Establish a new INFORMIX connection with transactions,
-	 * in case a new one needs to be created. Otherwise make
-	 * the requested connection current.
-	 */
-	if (!conn_cached)
-	{
-		ifxCreateConnectionXact(*coninfo);
-		elog(DEBUG2, "created new cached informix connection \"%s\"",
-			 (*coninfo)->conname);
+			state->param_values[i] = MemoryContextStrdup(oldcontext, strval);
+		}
+
+		elog(DEBUG2, "informix_fdw: param %d = %s", i,
+			 isnull ? "NULL" : state->param_values[i]);
+		i++;
 	}
-	else
+
+	MemoryContextSwitchTo(oldcontext);
+	ResetExprContext(econtext);
+}
+
+
+/*
+ * Estimates the rows and costs of a foreign scan whose remote
+ * query can't be prepared during planning, since it references
+ * key tables. The size of the remote table is taken from systables,
+ * the selectivity of the restriction clauses is estimated locally.
+ *
+ * The names of the statement, descriptor and cursor are generated
+ * nevertheless, ifxBeginForeignScan() prepares the query later.
+ */
+static void ifxEstimateScanLocally(PlannerInfo *root,
+								   RelOptInfo *baserel,
+								   IfxConnectionInfo *coninfo,
+								   IfxFdwExecutionState *state)
+{
+	IfxPlanData planData;
+	double      tuples = baserel->tuples;
+	double      pages  = baserel->pages;
+
+	if (coninfo->query == NULL)
+	{
+		ifxGetSystableStats(coninfo->tablename, &planData);
+
+		if (ifxGetSqlCode() == 0)
+		{
+			tuples = planData.nrows;
+			pages  = planData.npages;
+		}
+	}
+
+	/* never analyzed and no remote statistics either, assume 10 pages */
+	if (tuples <= 0)
+	{
+		pages  = 10;
+		tuples = pages * BLCKSZ / Max(IFX_REL_TARGET_WIDTH(baserel), 1);
+	}
+
+	coninfo->planData.estimated_rows
+		= clamp_row_est(tuples * clauselist_selectivity(root,
+														baserel->baserestrictinfo,
+														baserel->relid,
+														JOIN_INNER,
+														NULL));
+	coninfo->planData.costs = Max(pages, 1) * seq_page_cost;
+
+	state->stmt_info.stmt_name   = ifxGenStatementName(coninfo,
+													   state->stmt_info.refid);
+	state->stmt_info.descr_name  = ifxGenDescrName(coninfo,
+												   state->stmt_info.refid);
+	state->stmt_info.cursor_name = ifxGenCursorName(coninfo,
+													state->stmt_info.refid);
+}
+
+/*
+ * Creates the specified key table on the Informix server, unless
+ * it was already created within the session of the current
+ * connection. elemtype is the element type of the array loaded
+ * into the table later.
+ */
+static void ifxCreateKeyTable(IfxStatementInfo *info, char *tablename,
+							  Oid elemtype)
+{
+	IfxCachedConnection *cached;
+	StringInfoData       buf;
+	char                *coltype;
+	bool                 found;
+
+	cached = ifxConnCache_exists(info->conname, &found);
+
+	if (found && ifxConnCache_hasKeyTable(cached, tablename))
+		return;
+
+	/* should not happen, see ifxDeparseKeySet() */
+	if ((coltype = ifxKeyTableColumnType(elemtype)) == NULL)
+		elog(ERROR, "informix_fdw: unsupported key table type %u", elemtype);
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "CREATE TEMP TABLE %s(%s %s) WITH NO LOG",
+					 tablename, IFX_KEY_TABLE_COLUMN, coltype);
+
+	elog(DEBUG1, "informix_fdw: create key table \"%s\"", buf.data);
+
+	ifxExecuteImmediate(buf.data);
+
+	/*
+	 * The table might already exist, in case we've lost track of
+	 * it after a rollback to a savepoint.
+	 */
+	if ((ifxGetSqlCode() != IFX_TABLE_EXISTS)
+		&& (ifxGetSqlCode() != IFX_TEMP_TABLE_EXISTS))
+		ifxCatchExceptions(info, 0);
+
+	if (found)
+		ifxConnCache_addKeyTable(cached, tablename);
+}
+
+/*
+ * Loads the arrays of the key sets referenced by the remote
+ * query into their key tables. Any rows of a former scan
+ * are deleted before. A NULL array doesn't match any rows,
+ * so leaves its key table empty.
+ */
+static void ifxLoadKeyTables(IfxFdwExecutionState *state,
+							 ForeignScanState *node)
+{
+	ExprContext   *econtext = node->ss.ps.ps_ExprContext;
+	MemoryContext  oldcontext;
+	ListCell      *cell_table;
+	ListCell      *cell_expr;
+
+	oldcontext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	forboth(cell_table, state->key_tables, cell_expr, state->key_set_exprs)
+	{
+		char       *tablename = (char *) lfirst(cell_table);
+		ExprState  *exprstate = (ExprState *) lfirst(cell_expr);
+		StringInfoData buf;
+		Datum       value;
+		bool        isnull;
+
+		initStringInfo(&buf);
+		appendStringInfo(&buf, "DELETE FROM %s", tablename);
+		ifxExecuteImmediate(buf.data);
+		ifxCatchExceptions(&state->stmt_info, 0);
+
+		value = IFX_EXEC_EVAL_EXPR(exprstate, econtext, &isnull);
+
+		if (!isnull)
+		{
+			ArrayType *array = DatumGetArrayTypeP(value);
+			Oid        elemtype = ARR_ELEMTYPE(array);
+			int16      elemlen;
+			bool       elembyval;
+			char       elemalign;
+			Datum     *elems;
+			bool      *elemnulls;
+			int        nelems;
+			char     **values;
+			int        i;
+
+			get_typlenbyvalalign(elemtype, &elemlen, &elembyval, &elemalign);
+			deconstruct_array(array, elemtype, elemlen, elembyval, elemalign,
+							  &elems, &elemnulls, &nelems);
+
+			values = (char **) palloc(sizeof(char *) * (nelems + 1));
+
+			for (i = 0; i < nelems; i++)
+				values[i] = (elemnulls[i]) ? NULL
+					: ifxParamValueToString(elems[i], elemtype);
+
+			elog(DEBUG1, "informix_fdw: load %d keys into key table \"%s\"",
+				 nelems, tablename);
+
+			ifxLoadKeyTable(tablename, nelems, values);
+			ifxCatchExceptions(&state->stmt_info, 0);
+		}
+
+		ResetExprContext(econtext);
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+}
+
+#endif
+
+/*
+ * Entry point for scan preparation. Does all the leg work
+ * for preparing the query and cursor definitions before
+ * entering the executor.
+ */
+static void ifxPrepareScan(IfxConnectionInfo *coninfo,
+						   IfxFdwExecutionState *state)
+{
+	/*
+	 * Prepare parameters of the state structure
+	 * for scan later.
+	 */
+	ifxPrepareParamsForScan(state, coninfo);
+
+	/* Finally do the cursor preparation */
+	ifxPrepareCursorForScan(&state->stmt_info, coninfo);
+}
+
+/*
+ * Guts of connection establishing.
+ *
+ * Creates a new cached connection handle if not already cached
+ * and sets the connection current. If already cached, make the
+ * cached handle current, too.
+ *
+ * Returns the cached connection handle (either newly created or already
+ * cached).
+ */
+static IfxCachedConnection * ifxSetupConnection(IfxConnectionInfo **coninfo,
+												Oid foreignTableOid,
+												IfxForeignScanMode mode,
+												bool error_ok)
+{
+	IfxCachedConnection *cached_handle;
+	bool                 conn_cached;
+	IfxSqlStateClass     err;
+
+	/*
+	 * If not already done, initialize cache data structures.
+	 */
+	InformixCacheInit();
+
+	/*
+	 * Initialize connection structures and retrieve FDW options
+	 */
+
+	*coninfo = ifxMakeConnectionInfo(foreignTableOid);
+	elog(DEBUG1, "informix connection dsn \"%s\"", (*coninfo)->dsn);
+
+	/*
+	 * Set requested scan mode.
+	 */
+	(*coninfo)->scan_mode = mode;
+
+	/*
+	 * Lookup the connection name in the connection cache.
+	 */
+	cached_handle = ifxConnCache_add(foreignTableOid, *coninfo, &conn_cached);
+
+	/*
+	 * Establish a new INFORMIX connection with transactions,
+	 * in case a new one needs to be created. Otherwise make
+	 * the requested connection current.
+	 */
+	if (!conn_cached)
+	{
+		ifxCreateConnectionXact(*coninfo);
+		elog(DEBUG2, "created new cached informix connection \"%s\"",
+			 (*coninfo)->conname);
+	}
+	else
 	{
 		/*
 		 * Make the requested connection current.
@@ -1887,6 +3278,7 @@ static void ifxSetupFdwScan(IfxConnectionInfo **coninfo,
 	 * structure.
 	 */
 	*state = makeIfxFdwExecutionState(cached_handle->con.usage);
+	(*state)->foreignTableOid = foreignTableOid;
 
 	if ((*coninfo)->query)
 	{
@@ -1966,11 +3358,64 @@ static IfxFdwExecutionState *makeIfxFdwExecutionState(int refid)
 	 */
 	state->has_after_row_triggers = false;
 
+	/* no sorted or restricted output per default */
+	state->sort_clause = NULL;
+	state->limit_count = 0;
+
+	state->foreignTableOid = InvalidOid;
+
+	/* no placeholders in the remote query per default */
+	state->param_exprs  = NIL;
+	state->param_count  = 0;
+	state->param_values = NULL;
+
+	/* no key tables per default */
+	state->key_tables    = NIL;
+	state->key_set_exprs = NIL;
+	state->projected_attrs = NULL;
+
+	/* no batching per default, see ifxBeginForeignModify() */
+	state->batch_size  = 0;
+	state->batch_rows  = 0;
+	state->batch_start = 0;
+	state->batch_first_rowid = 0;
+	state->batch_values = NULL;
+	state->batch_nulls  = NULL;
+
+	/* no direct modify executed yet */
+	state->affected_rows = -1;
+
 	return state;
 }
 
 #if PG_VERSION_NUM >= 90200
 
+/*
+ * Calculate and convert statistics information retrieved
+ * from systables to match expectations of PostgreSQL...
+ *
+ * Default Informix installations run with 2KB block size
+ * but this could be configured depending on the tablespace.
+ *
+ * The idea is to calculate the numbers of pages to match
+ * the blocksize PostgreSQL currently uses to get a smarter
+ * cost estimate, thus the following formula is used:
+ *
+ * (npages * pagesize) / BLCKSZ
+ *
+ * If npage * pagesize is less than BLCKSZ, but the row estimate
+ * returned show a number larger than 0, we assume one block.
+ */
+static BlockNumber ifxSystablePages(IfxPlanData *planData)
+{
+	if (planData->nrows <= 0)
+		return 0;
+
+	return (BlockNumber) ((((planData->npages * planData->pagesize) / BLCKSZ) < 1)
+						  ? 1
+						  : (planData->npages * planData->pagesize) / BLCKSZ);
+}
+
 /*
  * Callback for ANALYZE
  */
@@ -1981,43 +3426,17 @@ ifxAnalyzeForeignTable(Relation relation, AcquireSampleRowsFunc *func,
 	IfxConnectionInfo    *coninfo;
 	IfxCachedConnection  *cached_handle;
 	IfxFdwExecutionState *state;
-	ForeignTable         *foreignTable;
-	ListCell             *elem;
-	bool                  is_table;
 	IfxPlanData           planData;
 	IfxSqlStateClass      errclass;
 
-	/*
-	 * Examine wether query or table is specified to form
-	 * the foreign table. In case we get a query, don't allow
-	 * ANALYZE to be run...
-	 */
-	foreignTable = GetForeignTable(RelationGetRelid(relation));
-	is_table     = false;
 	*totalpages  = 1;
 
-	foreach(elem, foreignTable->options)
-	{
-		DefElem *def = (DefElem *) lfirst(elem);
-		if (strcmp(def->defname, "table") == 0)
-			is_table = true;
-	}
-
 	/*
-	 * We don't support analyzing a foreign table which is based
-	 * on a SELECT. Proceed only in case coninfo->table is specified.
-	 *
-	 * We cannot simply error out here, since in case someone wants
-	 * to ANALYZE a whole database this will abort the whole run...
-	 *
-	 * XXX: However, it might have already cached a database connection. Leave
-	 * it for now, but we might want to close it, not sure...
+	 * Retrieve the remote indexes again the next time the
+	 * foreign table is planned, they might have changed.
 	 */
-	if (!is_table)
-	{
-		/* analyze.c already prints a WARNING message, so leave it out here */
-		return false;
-	}
+	ifxFTCache_resetIndexInfo(RelationGetRelid(relation));
+	ifxFTCache_resetFragmentInfo(RelationGetRelid(relation));
 
 	/*
 	 * Retrieve a connection from cache or open a new one. Instruct
@@ -2052,6 +3471,18 @@ ifxAnalyzeForeignTable(Relation relation, AcquireSampleRowsFunc *func,
 	 */
 	state = makeIfxFdwExecutionState(cached_handle->con.usage);
 
+	/*
+	 * A foreign table based on a query doesn't have any
+	 * statistics in systables. Go with the default of 1 page,
+	 * the number of rows is determined by the sample scan
+	 * then.
+	 */
+	if (coninfo->query != NULL)
+	{
+		*func = ifxAcquireSampleRows;
+		return true;
+	}
+
 	/*
 	 * Retrieve basic statistics from Informix for this table,
 	 * calculate totalpages according to them.
@@ -2110,39 +3541,38 @@ ifxAnalyzeForeignTable(Relation relation, AcquireSampleRowsFunc *func,
 			 RelationGetRelationName(relation), planData.nrows,
 			 planData.npages, planData.row_size, planData.pagesize);
 
-		/*
-		 * Calculate and convert statistics information to
-		 * match expectations of PostgreSQL...
-		 *
-		 * Default Informix installations run with 2KB block size
-		 * but this could be configured depending on the tablespace.
-		 *
-		 * The idea is to calculate the numbers of pages to match
-		 * the blocksize PostgreSQL currently uses to get a smarter
-		 * cost estimate, thus the following formula is used:
-		 *
-		 * (npages * pagesize) / BLCKSZ
-		 *
-		 * If npage * pagesize is less than BLCKSZ, but the row estimate
-		 * returned show a number larger than 0, we assume one block.
-		 */
-		if (planData.nrows > 0)
-		{
-			*totalpages
-				= (BlockNumber) ((((planData.npages * planData.pagesize) / BLCKSZ) < 1)
-								 ? 1
-								 : (planData.npages * planData.pagesize) / BLCKSZ);
-		}
-		else
-			*totalpages = 0;
+		*totalpages = ifxSystablePages(&planData);
 
 		elog(DEBUG1, "totalpages = %d", *totalpages);
 	}
 
 	*func = ifxAcquireSampleRows;
+
 	return true;
 }
 
+/*
+ * Returns the smallest prime number greater or equal to n.
+ */
+static int ifxNextPrime(int n)
+{
+	int candidate;
+
+	for (candidate = Max(n, 2); ; candidate++)
+	{
+		int divisor;
+
+		for (divisor = 2; divisor * divisor <= candidate; divisor++)
+		{
+			if (candidate % divisor == 0)
+				break;
+		}
+
+		if (divisor * divisor > candidate)
+			return candidate;
+	}
+}
+
 /*
  * Internal function for ANALYZE callback
  *
@@ -2163,6 +3593,9 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 	bool                 *nulls;
 	int                   rows_visited;
 	int                   rows_to_skip;
+	double                rows_seen;
+	double                remote_rows;
+	int                   sample_step;
 
 	elog(DEBUG1, "informix_fdw: analyze");
 
@@ -2171,6 +3604,9 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 	 */
 	*totalrows      = 0;
 	*totaldeadrows = 0;
+	rows_seen      = 0;
+	remote_rows    = 0;
+	sample_step    = 1;
 	rows_visited   = 0;
 	rows_to_skip   = -1; /* not set yet */
 	foreignTableId = RelationGetRelid(relation);
@@ -2196,6 +3632,66 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 	ifxSetupFdwScan(&coninfo, &state, &plan_values,
 					foreignTableId, IFX_BEGIN_SCAN);
 
+	/*
+	 * If ANALYZE was passed a column list, retrieve only
+	 * these columns. All others are NULL within the sample,
+	 * ANALYZE doesn't look at them anyways. A query which can't be
+	 * wrapped into a derived table returns all of its columns.
+	 */
+	if ((coninfo->query == NULL)
+		|| ifxQueryAllowsDerivedTable(coninfo))
+		state->projected_attrs = ifxGetAnalyzeColumns(foreignTableId);
+
+	/*
+	 * Let the Informix server do the sampling, if the remote
+	 * table is considerably larger than the requested sample.
+	 * Informix doesn't provide a random function within SQL, so
+	 * we select each row whose ROWID modulo a prime number equals
+	 * a random remainder. A prime number doesn't share any divisor
+	 * with the number of slots per page encoded in the ROWID, thus
+	 * the rows are spread over all pages and slots.
+	 *
+	 * The number of rows is taken from systables, so this requires
+	 * UPDATE STATISTICS to be run on the remote table. Without
+	 * a ROWID, all rows are fetched as before. The same applies to
+	 * a fragmented table: its ROWIDs (if created WITH ROWIDS) are
+	 * assigned independently of the physical position of a row.
+	 */
+	if (state->use_rowid && (coninfo->query == NULL))
+	{
+		IfxPlanData planData;
+
+		ifxGetSystableStats(coninfo->tablename, &planData);
+
+		if ((ifxSetException(&(state->stmt_info)) == IFX_SUCCESS)
+			&& (planData.nfragments == 0))
+			remote_rows = planData.nrows;
+
+		if (remote_rows > (double) targrows * IFX_SAMPLE_OVERSAMPLING)
+		{
+			StringInfoData buf;
+
+			sample_step = ifxNextPrime((int) Min(remote_rows / ((double) targrows * IFX_SAMPLE_OVERSAMPLING),
+												 (double) INT_MAX / 2));
+
+			initStringInfo(&buf);
+			appendStringInfo(&buf, "MOD(rowid, %d) = %d",
+							 sample_step,
+							 (int) (anl_random_fract() * sample_step));
+			state->stmt_info.predicate = buf.data;
+
+			/*
+			 * The sample predicate is the only one ever passed
+			 * for ANALYZE, so it is used regardless of
+			 * disable_predicate_pushdown.
+			 */
+			coninfo->predicate_pushdown = 1;
+
+			elog(DEBUG1, "informix_fdw: sampling remote table with \"%s\"",
+				 state->stmt_info.predicate);
+		}
+	}
+
 	/*
 	 * XXX: Move this into a separate function, shared
 	 * code with ifxBeginForeignScan()!!!
@@ -2321,7 +3817,7 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 	{
 		int i;
 
-		*totalrows += 1;
+		rows_seen += 1;
 
 		/*
 		 * Allow delay...
@@ -2391,7 +3887,7 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 			 */
 
 			if (rows_to_skip < 0)
-				rows_to_skip = anl_get_next_S(*totalrows, targrows, &anl_state);
+				rows_to_skip = anl_get_next_S(rows_seen, targrows, &anl_state);
 
 			if (rows_to_skip <= 0)
 			{
@@ -2422,11 +3918,31 @@ ifxAcquireSampleRows(Relation relation, int elevel, HeapTuple *rows,
 	/* Done, cleanup ... */
 	ifxRewindCallstack(&state->stmt_info);
 
-	ereport(elevel,
-			(errmsg("\"%s\": remote Informix table contains %.0f rows; "
-					"%d rows in sample",
-					RelationGetRelationName(relation),
-					*totalrows, rows_visited)));
+	/*
+	 * If sampled remotely, we only saw a fraction of the
+	 * rows. Report the number of rows from the remote statistics
+	 * then.
+	 */
+	if (sample_step > 1)
+	{
+		*totalrows = Max(remote_rows, rows_seen);
+
+		ereport(elevel,
+				(errmsg("\"%s\": remote Informix table contains %.0f rows; "
+						"%.0f rows sampled remotely, %d rows in sample",
+						RelationGetRelationName(relation),
+						*totalrows, rows_seen, rows_visited)));
+	}
+	else
+	{
+		*totalrows = rows_seen;
+
+		ereport(elevel,
+				(errmsg("\"%s\": remote Informix table contains %.0f rows; "
+						"%d rows in sample",
+						RelationGetRelationName(relation),
+						*totalrows, rows_visited)));
+	}
 
 	return rows_visited;
 }
@@ -2445,11 +3961,13 @@ static void ifxGetForeignRelSize(PlannerInfo *planInfo,
 	List                 *plan_values;
 	IfxFdwExecutionState *state;
 	IfxFdwPlanState      *planState;
+	ListCell             *cell;
 
 	elog(DEBUG3, "informix_fdw: get foreign relation size, cmd %d",
 		planInfo->parse->commandType);
 
-	planState = palloc(sizeof(IfxFdwPlanState));
+	planState = palloc0(sizeof(IfxFdwPlanState));
+	planState->foreignTableOid = foreignTableId;
 
 	/*
 	 * Establish remote informix connection or get
@@ -2469,6 +3987,15 @@ static void ifxGetForeignRelSize(PlannerInfo *planInfo,
 								state,
 								planInfo->parse->commandType);
 
+	/*
+	 * Predicates are pushed down to a foreign table based on a
+	 * query by wrapping it into a derived table. If that isn't
+	 * possible, all predicates are evaluated locally.
+	 */
+	if ((coninfo->query != NULL)
+		&& !ifxQueryAllowsDerivedTable(coninfo))
+		coninfo->predicate_pushdown = 0;
+
 	/*
 	 * Check for predicates that can be pushed down
 	 * to the informix server, but skip it in case the user
@@ -2483,7 +4010,10 @@ static void ifxGetForeignRelSize(PlannerInfo *planInfo,
 		 */
 		state->stmt_info.predicate = ifxFilterQuals(planInfo, baserel,
 													&(planState->excl_restrictInfo),
-													foreignTableId);
+													foreignTableId, coninfo,
+													&(planState->param_exprs),
+													coninfo->enable_key_tables ? &(planState->key_sets) : NULL,
+													state->stmt_info.refid);
 		elog(DEBUG2, "predicate for pushdown: %s", state->stmt_info.predicate);
 	}
 	else
@@ -2518,28 +4048,86 @@ static void ifxGetForeignRelSize(PlannerInfo *planInfo,
 		state->stmt_info.cursorUsage = IFX_UPDATE_CURSOR;
 	}
 
-	ifxPrepareScan(coninfo, state);
+	/*
+	 * Key tables referenced by the predicate are created by
+	 * ifxBeginForeignScan(), the remote query can't be prepared
+	 * before. Estimate the scan locally in this case.
+	 */
+	foreach(cell, planState->key_sets)
+	{
+		IfxKeySet *key_set = (IfxKeySet *) lfirst(cell);
+
+		state->key_tables = lappend(state->key_tables, key_set->tablename);
+	}
+
+	if (state->key_tables == NIL)
+	{
+		ifxPrepareScan(coninfo, state);
+
+		/*
+		 * Now it should be possible to get the cost estimates
+		 * from the actual cursor.
+		 */
+		coninfo->planData.estimated_rows = (double) ifxGetSQLCAErrd(SQLCA_NROWS_PROCESSED);
+		coninfo->planData.costs          = (double) ifxGetSQLCAErrd(SQLCA_NROWS_WEIGHT);
+	}
+	else
+	{
+		ifxPrepareParamsForScan(state, coninfo);
+		ifxEstimateScanLocally(planInfo, baserel, coninfo, state);
+	}
+
+	planState->coninfo   = coninfo;
+	planState->state     = state;
 
 	/*
-	 * Now it should be possible to get the cost estimates
-	 * from the actual cursor.
+	 * Retrieve the fragments of the remote table, their
+	 * row counts are more accurate for fragmented tables.
 	 */
-	coninfo->planData.estimated_rows = (double) ifxGetSQLCAErrd(SQLCA_NROWS_PROCESSED);
-	coninfo->planData.costs          = (double) ifxGetSQLCAErrd(SQLCA_NROWS_WEIGHT);
+	ifxGetForeignFragments(baserel, planState);
 
 	/*
-	 * Estimate total_cost in conjunction with the per-tuple cpu cost
-	 * for FETCHing each particular tuple later on.
+	 * Retrieve the indexes of the remote table. If the pushed down
+	 * equality predicates match all columns of a unique index, at most
+	 * a single row is returned by an index lookup.
 	 */
-	coninfo->planData.total_costs    = coninfo->planData.costs
-		+ (coninfo->planData.estimated_rows * cpu_tuple_cost);
+	ifxGetForeignIndexes(baserel, planState);
 
-	/* should be calculated nrows from foreign table */
-	baserel->rows        = coninfo->planData.estimated_rows;
-	planState->coninfo   = coninfo;
-	planState->state     = state;
-	baserel->fdw_private = (void *) planState;
-}
+	if (coninfo->predicate_pushdown)
+	{
+		List        *pushed_down = NIL;
+		IfxIndexDef *index;
+
+		foreach(cell, baserel->baserestrictinfo)
+		{
+			RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+
+			if (!list_member_ptr(planState->excl_restrictInfo, rinfo))
+				pushed_down = lappend(pushed_down, rinfo->clause);
+		}
+
+		index = ifxMatchIndex(planState,
+							  ifxEqualityAttnums(pushed_down, baserel->relid));
+
+		if ((index != NULL) && index->unique)
+		{
+			coninfo->planData.estimated_rows = Min(coninfo->planData.estimated_rows, 1.0);
+			coninfo->planData.costs          = Min(coninfo->planData.costs,
+												   random_page_cost * IFX_INDEX_TREE_HEIGHT);
+		}
+	}
+
+	/*
+	 * Estimate total_cost in conjunction with the per-tuple cpu cost
+	 * for FETCHing each particular tuple later on.
+	 */
+	coninfo->planData.total_costs    = coninfo->planData.costs
+		+ (coninfo->planData.estimated_rows * cpu_tuple_cost);
+
+	/* should be calculated nrows from foreign table */
+	baserel->rows        = coninfo->planData.estimated_rows;
+	baserel->fdw_private = (void *) planState;
+}
 
 /*
  * Create possible access paths for the foreign data
@@ -2551,76 +4139,1759 @@ static void ifxGetForeignPaths(PlannerInfo *root,
 							   Oid foreignTableId)
 {
 	IfxFdwPlanState *planState;
+	List            *useful_pathkeys;
+	ListCell        *cell;
+	int              limit_count;
+	bool             nulls_ordering;
 
 	elog(DEBUG3, "informix_fdw: get foreign paths");
 
 	planState = (IfxFdwPlanState *) baserel->fdw_private;
 
+	/*
+	 * Check wether the remote query can be restricted to
+	 * the number of rows requested by a LIMIT clause.
+	 */
+	limit_count = ifxGetLimitForPushdown(root, baserel, planState);
+
 	/*
 	 * Create a generic foreign path for now. We need to consider any
 	 * restriction quals later, to get a smarter path generation here.
 	 *
 	 * For example, it is quite interesting to consider any index scans
-	 * or sorted output on the remote side and reflect it in the
-	 * choosen paths (helps nested loops et al.).
+	 * on the remote side and reflect it in the choosen paths.
+	 */
+	ifxAddForeignPath(root, baserel, NIL, NULL, 0,
+					  planState->coninfo->planData.costs,
+					  planState->coninfo->planData.total_costs);
+
+	/*
+	 * A LIMIT without ORDER BY can be applied to the
+	 * unsorted remote query directly.
+	 */
+	if ((limit_count > 0) && (root->query_pathkeys == NIL))
+		ifxAddForeignPath(root, baserel, NIL, NULL, limit_count,
+						  planState->coninfo->planData.costs,
+						  planState->coninfo->planData.total_costs);
+
+#if PG_VERSION_NUM >= 90300
+	/*
+	 * Consider parameterized paths for join clauses with
+	 * other relations.
+	 */
+	ifxAddForeignParamPaths(root, baserel, planState);
+#endif
+
+	/*
+	 * Consider sorted output from the Informix server. Foreign tables
+	 * based on a query are sorted as a derived table, see
+	 * ifxPrepareParamsForScan(). An updatable cursor doesn't allow an
+	 * ORDER BY clause.
+	 */
+	if ((planState->state->stmt_info.cursorUsage == IFX_UPDATE_CURSOR)
+		|| ((planState->coninfo->query != NULL)
+			&& !ifxQueryAllowsDerivedTable(planState->coninfo)))
+		return;
+
+	useful_pathkeys = ifxGetUsefulPathkeys(root, baserel);
+
+	if (useful_pathkeys == NIL)
+		return;
+
+	nulls_ordering = (ifxGetCachedServerVersion(planState->coninfo)
+					  >= IFX_NULLS_ORDERING_MIN_VERSION);
+
+	foreach(cell, useful_pathkeys)
+	{
+		List *pathkeys = (List *) lfirst(cell);
+		char *sort_clause;
+		Path  sort_path;
+
+		sort_clause = ifxDeparsePathkeys(baserel, foreignTableId, pathkeys,
+										 nulls_ordering);
+
+		/* not safe to push down */
+		if (sort_clause == NULL)
+			continue;
+
+		/*
+		 * We don't get any cost estimates for the sort from the
+		 * Informix server, so charge what sorting the rows of the remote
+		 * query would cost locally on top of the remote query.
+		 */
+		cost_sort(&sort_path, root, pathkeys,
+				  planState->coninfo->planData.costs,
+				  baserel->rows, IFX_REL_TARGET_WIDTH(baserel),
+				  0.0, work_mem, -1.0);
+
+		ifxAddForeignPath(root, baserel, pathkeys, sort_clause, 0,
+						  sort_path.startup_cost,
+						  sort_path.total_cost + (baserel->rows * cpu_tuple_cost));
+
+		/*
+		 * A LIMIT together with an ORDER BY can only be pushed
+		 * down in case the remote query returns the rows in the
+		 * order requested by the query.
+		 */
+		if ((limit_count > 0) && (pathkeys == root->query_pathkeys))
+			ifxAddForeignPath(root, baserel, pathkeys, sort_clause, limit_count,
+							  sort_path.startup_cost,
+							  sort_path.total_cost + (baserel->rows * cpu_tuple_cost));
+	}
+}
+
+/*
+ * Adds a foreign path to the specified relation.
+ *
+ * sort_clause is the deparsed ORDER BY clause in case the path returns
+ * sorted output and limit_count the number of rows to be fetched from
+ * the remote server (0 if the remote query isn't restricted). Both are
+ * remembered within the path, ifxGetForeignPlan() will regenerate the
+ * remote query in case the path gets choosen.
+ */
+static void ifxAddForeignPath(PlannerInfo *root,
+							  RelOptInfo  *baserel,
+							  List        *pathkeys,
+							  char        *sort_clause,
+							  int          limit_count,
+							  Cost         startup_cost,
+							  Cost         total_cost)
+{
+	List   *fdw_private = NIL;
+	double  rows        = baserel->rows;
+
+	/*
+	 * If the remote query is restricted, we transfer
+	 * less rows from the Informix server. Reduce the
+	 * run costs accordingly.
 	 */
+	if ((limit_count > 0) && (limit_count < rows))
+	{
+		total_cost = startup_cost
+			+ (total_cost - startup_cost) * (limit_count / rows);
+		rows       = limit_count;
+	}
+
+	if ((sort_clause != NULL) || (limit_count > 0))
+	{
+		fdw_private = list_make2(makeString((sort_clause != NULL) ? sort_clause : ""),
+								 makeInteger(limit_count));
+	}
+
 	add_path(baserel, (Path *)
-			 create_foreignscan_path(root, baserel,
-									 baserel->rows,
-									 planState->coninfo->planData.costs,
-									 planState->coninfo->planData.total_costs,
-									 NIL,
-									 NULL,
-									 NIL));
+			 IFX_CREATE_FOREIGNSCAN_PATH(root, baserel,
+										 NULL,
+										 rows,
+										 startup_cost,
+										 total_cost,
+										 pathkeys,
+										 fdw_private));
 }
 
-static ForeignScan *ifxGetForeignPlan(PlannerInfo *root,
-									  RelOptInfo *baserel,
-									  Oid foreignTableId,
-									  ForeignPath *best_path,
-									  List *tlist,
-									  List *scan_clauses)
+/*
+ * Retrieves the indexes of the remote table and maps their
+ * columns to the local columns of the foreign table. The
+ * index information is cached per foreign table until the next
+ * ANALYZE. Only the leading index columns which exist in the
+ * foreign table are recorded.
+ */
+static void ifxGetForeignIndexes(RelOptInfo *baserel,
+								 IfxFdwPlanState *planState)
 {
-	Index scan_relid;
-	IfxFdwPlanState  *planState;
-	List             *plan_values;
+	IfxConnectionInfo *coninfo = planState->coninfo;
+	IfxFTCacheItem    *item;
+	Relation           foreignRel;
+	TupleDesc          tupdesc;
+	int                i;
 
-	elog(DEBUG3, "informix_fdw: get foreign plan");
+	planState->has_index_info = false;
+	planState->indexes        = NIL;
 
-	scan_relid = baserel->relid;
-	planState = (IfxFdwPlanState *) baserel->fdw_private;
+	/* there are no indexes for a foreign table based on a query */
+	if (coninfo->tablename == NULL)
+		return;
+
+	item = ifxFTCache_add(planState->foreignTableOid, coninfo->conname);
+
+	if (!item->has_index_info)
+	{
+		IfxIndexInfo *indexes;
+		int           nindexes;
+
+		indexes  = (IfxIndexInfo *) palloc(sizeof(IfxIndexInfo) * IFX_MAX_INDEXES);
+		nindexes = ifxGetIndexInfo(coninfo->tablename, indexes, IFX_MAX_INDEXES);
+
+		if (nindexes < 0)
+		{
+			IfxSqlStateMessage message;
+
+			/*
+			 * Don't bother the user, the foreign table is planned
+			 * without any knowledge about remote indexes then.
+			 */
+			ifxGetSqlStateMessage(1, &message);
+			elog(DEBUG1, "informix_fdw: could not retrieve indexes of table \"%s\": %s",
+				 coninfo->tablename, message.text);
+			pfree(indexes);
+			return;
+		}
+
+		ifxFTCache_setIndexInfo(item, nindexes, indexes);
+		pfree(indexes);
+	}
+
+	/* open foreign table, should be locked already */
+	foreignRel = heap_open(planState->foreignTableOid, NoLock);
+	tupdesc    = RelationGetDescr(foreignRel);
+
+	for (i = 0; i < item->nindexes; i++)
+	{
+		IfxIndexInfo *info = &item->indexes[i];
+		IfxIndexDef  *index;
+		int           j;
+
+		index = (IfxIndexDef *) palloc(sizeof(IfxIndexDef));
+		index->attnums  = (AttrNumber *) palloc(sizeof(AttrNumber) * info->nparts);
+		index->ncolumns = 0;
+
+		for (j = 0; j < info->nparts; j++)
+		{
+			AttrNumber attnum = InvalidAttrNumber;
+			int        k;
+
+			for (k = 0; k < tupdesc->natts; k++)
+			{
+				Form_pg_attribute attr = TupleDescAttr(tupdesc, k);
+
+				if (attr->attisdropped)
+					continue;
+
+				if (pg_strcasecmp(ifxGetRemoteColumnName(planState->foreignTableOid,
+														 attr->attnum),
+								  info->colnames[j]) == 0)
+				{
+					attnum = attr->attnum;
+					break;
+				}
+			}
+
+			if (attnum == InvalidAttrNumber)
+				break;
+
+			index->attnums[index->ncolumns++] = attnum;
+		}
+
+		if (index->ncolumns == 0)
+			continue;
+
+		index->unique = (info->unique && (index->ncolumns == info->nparts));
+		planState->indexes = lappend(planState->indexes, index);
+
+		elog(DEBUG2, "informix_fdw: remote %sindex on %d column(s) of table \"%s\"",
+			 index->unique ? "unique " : "", index->ncolumns,
+			 coninfo->tablename);
+
+	}
+
+	heap_close(foreignRel, NoLock);
+
+	planState->has_index_info = true;
+}
+
+/*
+ * Retrieves the fragments of the remote table from sysfragments.
+ * Like the indexes, they are cached per foreign table until the
+ * next ANALYZE.
+ *
+ * The sum of the row counts of all fragments replaces the number
+ * of tuples of the foreign table, which is only as current as the
+ * last ANALYZE.
+ */
+static void ifxGetForeignFragments(RelOptInfo *baserel,
+								   IfxFdwPlanState *planState)
+{
+	IfxConnectionInfo *coninfo = planState->coninfo;
+	IfxFTCacheItem    *item;
+	double             nrows;
+	int                i;
+
+	planState->has_fragment_info = false;
+	planState->nfragments        = 0;
+	planState->fragments         = NULL;
+
+	/* a query doesn't have any fragments */
+	if (coninfo->tablename == NULL)
+		return;
+
+	item = ifxFTCache_add(planState->foreignTableOid, coninfo->conname);
+
+	if (!item->has_fragment_info)
+	{
+		IfxFragmentInfo *fragments;
+		int              nfragments;
+
+		fragments  = (IfxFragmentInfo *) palloc(sizeof(IfxFragmentInfo) * IFX_MAX_FRAGMENTS);
+		nfragments = ifxGetFragmentInfo(coninfo->tablename, fragments,
+										IFX_MAX_FRAGMENTS);
+
+		if (nfragments < 0)
+		{
+			IfxSqlStateMessage message;
+
+			ifxGetSqlStateMessage(1, &message);
+			elog(DEBUG1, "informix_fdw: could not retrieve fragments of table \"%s\": %s",
+				 coninfo->tablename, message.text);
+			pfree(fragments);
+			return;
+		}
+
+		ifxFTCache_setFragmentInfo(item, nfragments, fragments);
+		pfree(fragments);
+	}
+
+	planState->has_fragment_info = true;
+	planState->nfragments        = item->nfragments;
+
+	if (item->nfragments == 0)
+		return;
+
+	planState->fragments = (IfxFragmentInfo *) palloc(sizeof(IfxFragmentInfo)
+													  * item->nfragments);
+	memcpy(planState->fragments, item->fragments,
+		   sizeof(IfxFragmentInfo) * item->nfragments);
+
+	nrows = 0;
+	for (i = 0; i < item->nfragments; i++)
+	{
+		elog(DEBUG2, "informix_fdw: fragment %d \"%s\" of table \"%s\": %.0f rows, expression \"%s\"",
+			 item->fragments[i].evalpos, item->fragments[i].partition,
+			 coninfo->tablename, item->fragments[i].nrows,
+			 item->fragments[i].exprtext);
+		nrows += item->fragments[i].nrows;
+	}
 
 	/*
-	 * In case we are allowed to push down query predicates, ifxFilterQuals()
-	 * would have filtered out all remote scan clauses and we need to
-	 * examine all excluded clauses only.
-	 *
-	 * NOTE: ifxFilterQuals() won't be called in case predicate_pushdown is
-	 *       disabled. In this case we don't filter at all so pass all
-	 *       scan claususes "as-is" but with all pseudoconstants filtered.
+	 * Fragments beyond IFX_MAX_FRAGMENTS aren't recorded, the
+	 * sum would be too low then.
 	 */
-	if (planState->coninfo->predicate_pushdown)
-		scan_clauses = extract_actual_clauses(planState->excl_restrictInfo, false);
-	else
-		scan_clauses = extract_actual_clauses(scan_clauses, false);
+	if ((nrows > 0) && (item->nfragments < IFX_MAX_FRAGMENTS))
+		baserel->tuples = nrows;
+}
+
+/*
+ * Returns the attribute numbers of the columns of the specified
+ * relation compared by an equality operator in clauses (a list of
+ * bare clauses, not RestrictInfo).
+ */
+static Bitmapset *ifxEqualityAttnums(List *clauses, Index relid)
+{
+	Bitmapset *result = NULL;
+	ListCell  *cell;
+
+	foreach(cell, clauses)
+	{
+		Expr   *clause = (Expr *) lfirst(cell);
+		OpExpr *op;
+		Node   *larg;
+		Node   *rarg;
+
+		if (!IsA(clause, OpExpr))
+			continue;
+
+		op = (OpExpr *) clause;
+
+		if ((list_length(op->args) != 2)
+			|| (get_oprrest(op->opno) != F_EQSEL))
+			continue;
+
+		larg = (Node *) linitial(op->args);
+		rarg = (Node *) lsecond(op->args);
+
+		if (IsA(larg, RelabelType))
+			larg = (Node *) ((RelabelType *) larg)->arg;
+		if (IsA(rarg, RelabelType))
+			rarg = (Node *) ((RelabelType *) rarg)->arg;
+
+		/* let the column reference be the left operand */
+		if (!IsA(larg, Var) || (((Var *) larg)->varno != relid))
+		{
+			Node *tmp = larg;
+
+			larg = rarg;
+			rarg = tmp;
+		}
+
+		if (IsA(larg, Var)
+			&& (((Var *) larg)->varno == relid)
+			&& (((Var *) larg)->varlevelsup == 0)
+			&& (((Var *) larg)->varattno > 0)
+			&& !bms_is_member(relid, pull_varnos(rarg))
+			&& !contain_volatile_functions(rarg))
+			result = bms_add_member(result, ((Var *) larg)->varattno);
+	}
+
+	return result;
+}
+
+/*
+ * Returns a remote index usable to look up rows by the columns
+ * in eq_attnums, that is, its leading column is among them. A
+ * unique index with all columns in eq_attnums is preferred. Returns
+ * NULL if no such index exists.
+ */
+static IfxIndexDef *ifxMatchIndex(IfxFdwPlanState *planState,
+								  Bitmapset *eq_attnums)
+{
+	IfxIndexDef *result = NULL;
+	ListCell    *cell;
+
+	foreach(cell, planState->indexes)
+	{
+		IfxIndexDef *index = (IfxIndexDef *) lfirst(cell);
+		int          i;
+
+		if (!bms_is_member(index->attnums[0], eq_attnums))
+			continue;
+
+		if (index->unique)
+		{
+			for (i = 1; i < index->ncolumns; i++)
+			{
+				if (!bms_is_member(index->attnums[i], eq_attnums))
+					break;
+			}
+
+			if (i == index->ncolumns)
+				return index;
+		}
+
+		if (result == NULL)
+			result = index;
+	}
+
+	return result;
+}
+
+#if PG_VERSION_NUM >= 90300
+
+/*
+ * Returns true in case the leading columns of the specified index,
+ * as far as they are looked up by eq_attnums, include one of the
+ * columns in join_attnums.
+ */
+static bool ifxIndexCoversJoinColumn(IfxIndexDef *index,
+									 Bitmapset *eq_attnums,
+									 Bitmapset *join_attnums)
+{
+	int i;
+
+	for (i = 0; (i < index->ncolumns) && bms_is_member(index->attnums[i], eq_attnums); i++)
+	{
+		if (bms_is_member(index->attnums[i], join_attnums))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Callback for generate_implied_equalities_for_column(), matches
+ * any column of the specified foreign table.
+ */
+static bool ifxEcMemberMatchesForeign(PlannerInfo *root,
+									  RelOptInfo *rel,
+									  EquivalenceClass *ec,
+									  EquivalenceMember *em,
+									  void *arg)
+{
+	Expr *expr = em->em_expr;
+
+	if (IsA(expr, RelabelType))
+		expr = ((RelabelType *) expr)->arg;
+
+	return (IsA(expr, Var)
+			&& (((Var *) expr)->varno == rel->relid)
+			&& (((Var *) expr)->varlevelsup == 0)
+			&& (((Var *) expr)->varattno > 0));
+}
+
+/*
+ * Adds parameterized foreign paths to the specified relation for
+ * equality join clauses with other relations. Used as the inner side
+ * of a nested loop, the values of the outer relation are bound to the
+ * remote query each time the cursor is reopened, so only matching
+ * rows are transferred from the Informix server instead of scanning
+ * the whole remote table for a hash or merge join.
+ */
+static void ifxAddForeignParamPaths(PlannerInfo *root,
+									RelOptInfo *baserel,
+									IfxFdwPlanState *planState)
+{
+	List     *clauses;
+	List     *ppi_list = NIL;
+	Relids    prohibited_rels = NULL;
+	ListCell *cell;
+
+	/*
+	 * Join clauses are pushed down like any other predicate,
+	 * so honor disable_predicate_pushdown. An updatable cursor
+	 * can't be reopened with different parameters.
+	 */
+	if (!planState->coninfo->predicate_pushdown
+		|| (planState->state->stmt_info.cursorUsage == IFX_UPDATE_CURSOR))
+		return;
+
+#if PG_VERSION_NUM >= 90400
+	prohibited_rels = baserel->lateral_referencers;
+#endif
+
+	clauses = generate_implied_equalities_for_column(root, baserel,
+													 ifxEcMemberMatchesForeign,
+													 NULL,
+													 prohibited_rels);
+
+	foreach(cell, clauses)
+	{
+		RestrictInfo  *rinfo = (RestrictInfo *) lfirst(cell);
+		Relids         required_outer;
+		List          *params = NIL;
+
+		required_outer = bms_del_member(bms_copy(rinfo->clause_relids),
+										baserel->relid);
+
+		if (bms_is_empty(required_outer))
+			continue;
+
+		if (ifxDeparseParamJoinClause(rinfo->clause, baserel->relid,
+									  planState->foreignTableOid,
+									  &params) == NULL)
+			continue;
+
+		ppi_list = list_append_unique_ptr(ppi_list,
+										  get_baserel_parampathinfo(root, baserel,
+																	required_outer));
+	}
+
+	foreach(cell, ppi_list)
+	{
+		ParamPathInfo *param_info = (ParamPathInfo *) lfirst(cell);
+		IfxIndexDef   *index;
+		Bitmapset     *join_attnums;
+		Bitmapset     *eq_attnums;
+		double         rows;
+		Cost           startup_cost;
+		Cost           total_cost;
+
+		rows = param_info->ppi_rows;
+
+		/*
+		 * Check wether the pushed down restrictions together with
+		 * the join clauses match a remote index.
+		 */
+		join_attnums = ifxEqualityAttnums(extract_actual_clauses(param_info->ppi_clauses,
+																 false),
+										  baserel->relid);
+		eq_attnums   = bms_union(ifxEqualityAttnums(extract_actual_clauses(baserel->baserestrictinfo,
+																		   false),
+													baserel->relid),
+								 join_attnums);
+		index = ifxMatchIndex(planState, eq_attnums);
+
+		if (!planState->has_index_info)
+		{
+			/*
+			 * Without any knowledge about the remote indexes, we
+			 * must assume each rescan scans the whole remote table.
+			 */
+			startup_cost = IFX_PARAM_PATH_STARTUP_COST
+				+ planState->coninfo->planData.costs;
+			total_cost   = startup_cost + (rows * cpu_tuple_cost);
+		}
+		else if ((index != NULL)
+				 && ifxIndexCoversJoinColumn(index, eq_attnums, join_attnums))
+		{
+			/*
+			 * Each rescan is an index lookup on the Informix server,
+			 * a unique index returns a single row at most.
+			 */
+			if (index->unique)
+				rows = Min(rows, 1.0);
+
+			startup_cost = IFX_PARAM_PATH_STARTUP_COST
+				+ (random_page_cost * IFX_INDEX_TREE_HEIGHT);
+			total_cost   = startup_cost
+				+ (rows * (random_page_cost + cpu_tuple_cost));
+		}
+		else
+		{
+			/*
+			 * No remote index can look up rows by the join columns,
+			 * so each rescan would scan the whole remote table. That's
+			 * never better than joining a single scan locally.
+			 */
+			continue;
+		}
+
+		add_path(baserel, (Path *)
+				 IFX_CREATE_FOREIGNSCAN_PARAM_PATH(root, baserel,
+												   rows,
+												   startup_cost,
+												   total_cost,
+												   param_info->ppi_req_outer,
+												   NIL));
+	}
+}
+
+/*
+ * Adds the join clauses of a parameterized foreign path to the
+ * pushed down predicate of the remote query. The expressions of
+ * the outer relation are appended to param_exprs, the RestrictInfos
+ * of the clauses pushed down to pushed_clauses. Clauses not supported
+ * are left to be checked locally by the caller.
+ */
+static void ifxPushdownParamJoinClauses(IfxFdwPlanState *planState,
+										RelOptInfo *baserel,
+										List *join_clauses,
+										List **pushed_clauses,
+										List **param_exprs)
+{
+	IfxFdwExecutionState *state = planState->state;
+	StringInfoData        buf;
+	ListCell             *cell;
+
+	initStringInfo(&buf);
+
+	if ((state->stmt_info.predicate != NULL)
+		&& (strlen(state->stmt_info.predicate) > 0))
+		appendStringInfoString(&buf, state->stmt_info.predicate);
+
+	foreach(cell, join_clauses)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+		char         *deparsed;
+
+		deparsed = ifxDeparseParamJoinClause(rinfo->clause, baserel->relid,
+											 planState->foreignTableOid,
+											 param_exprs);
+
+		if (deparsed == NULL)
+			continue;
+
+		*pushed_clauses = lappend(*pushed_clauses, rinfo);
+		appendStringInfo(&buf, "%s%s",
+						 (buf.len > 0) ? " AND " : "",
+						 deparsed);
+	}
+
+	state->stmt_info.predicate = buf.data;
+	elog(DEBUG2, "informix_fdw: predicate with join clauses \"%s\"", buf.data);
+}
+
+/*
+ * Returns true if the specified expression references executor
+ * parameters, e.g. values of the outer relation of a nested loop.
+ */
+static bool ifxContainsExecParam(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Param) && (((Param *) node)->paramkind == PARAM_EXEC))
+		return true;
+
+	return expression_tree_walker(node, ifxContainsExecParam, context);
+}
+
+#endif
+
+/*
+ * Returns the number of rows the remote query can be restricted to
+ * in case the query has a LIMIT clause, 0 otherwise.
+ *
+ * The planner tells us via limit_tuples how many rows are required
+ * to satisfy LIMIT and OFFSET. This is only safe to be pushed down
+ * in case the foreign table is the only relation of a plain SELECT and
+ * all restriction clauses are evaluated on the Informix server.
+ *
+ * NOTE: The local Limit node stays in place, so OFFSET isn't pushed down
+ *       as SKIP, since the Limit node skips the rows itself. Replacing
+ *       the Limit node would require a path for UPPERREL_FINAL. PostgreSQL
+ *       9.6 up to 11 call ifxGetForeignUpperPaths() for it, but don't tell
+ *       the LIMIT and OFFSET values (FinalPathExtraData was introduced
+ *       with PostgreSQL 12, which this FDW doesn't support). Such a path
+ *       would have to take over the sorting, row marks and final target
+ *       list of the query, too, which we don't plan remotely. Thus
+ *       FIRST n covers the rows for OFFSET and LIMIT both.
+ */
+static int ifxGetLimitForPushdown(PlannerInfo *root,
+								  RelOptInfo *baserel,
+								  IfxFdwPlanState *planState)
+{
+	Query *parse = root->parse;
+
+	if ((root->limit_tuples <= 0)
+		|| (root->limit_tuples > (double) INT_MAX))
+		return 0;
+
+	if ((parse->commandType != CMD_SELECT)
+		|| (parse->rowMarks != NIL))
+		return 0;
+
+	/* the foreign table must be the only relation */
+	if ((baserel->reloptkind != RELOPT_BASEREL)
+		|| (bms_membership(root->all_baserels) != BMS_SINGLETON))
+		return 0;
+
+	/* set returning functions might return more rows */
+	if (expression_returns_set((Node *) parse->targetList))
+		return 0;
+
+	/*
+	 * Any restriction clauses evaluated locally might filter
+	 * out rows.
+	 */
+	if (ifxHasLocalQuals(baserel, planState))
+		return 0;
+
+	/* FIRST requires the query to be wrapped into a derived table */
+	if ((planState->coninfo->query != NULL)
+		&& !ifxQueryAllowsDerivedTable(planState->coninfo))
+		return 0;
+
+	return (int) root->limit_tuples;
+}
+
+/*
+ * Returns true if any restriction clauses of the specified
+ * foreign relation can't be evaluated on the Informix server.
+ */
+static bool ifxHasLocalQuals(RelOptInfo *baserel,
+							 IfxFdwPlanState *planState)
+{
+	if (planState->coninfo->predicate_pushdown)
+		return (planState->excl_restrictInfo != NIL);
+	else
+		return (baserel->baserestrictinfo != NIL);
+}
+
+/*
+ * Returns a list of pathkey lists, which are considered to be
+ * useful for sorted output of the specified foreign relation. These
+ * are the pathkeys of the query itself (e.g. ORDER BY) and any
+ * canonical pathkey of an equivalence class joining the foreign relation
+ * with other relations, which might help merge joins.
+ */
+static List *ifxGetUsefulPathkeys(PlannerInfo *root,
+								  RelOptInfo *baserel)
+{
+	List     *result = NIL;
+	ListCell *cell;
+
+	if (root->query_pathkeys != NIL)
+		result = lappend(result, root->query_pathkeys);
+
+	if (!baserel->has_eclass_joins)
+		return result;
+
+	foreach(cell, root->canon_pathkeys)
+	{
+		PathKey          *pathkey = (PathKey *) lfirst(cell);
+		EquivalenceClass *ec      = pathkey->pk_eclass;
+
+		/*
+		 * Only consider join equivalence classes referencing
+		 * our foreign relation.
+		 */
+		if (!bms_is_member(baserel->relid, ec->ec_relids)
+			|| (bms_num_members(ec->ec_relids) <= 1))
+			continue;
+
+		/* already covered by the query pathkeys */
+		if ((root->query_pathkeys != NIL)
+			&& (linitial(root->query_pathkeys) == pathkey))
+			continue;
+
+		result = lappend(result, list_make1(pathkey));
+	}
+
+	return result;
+}
+
+/*
+ * Regenerates the remote query of a foreign scan in case the planner
+ * has choosen a path which requires a query different from the one
+ * prepared by ifxGetForeignRelSize(), e.g. with sorted output.
+ *
+ * All resources of the formerly prepared statement are released, so that
+ * ifxBeginForeignScan() will prepare the new query again.
+ */
+static void ifxRegenerateScanQuery(IfxFdwPlanState *planState)
+{
+	/*
+	 * Make sure we release the resources on the right
+	 * connection, there might be other foreign tables planned
+	 * in the meantime.
+	 */
+	ifxSetConnection(planState->coninfo);
+	ifxRewindCallstack(&planState->state->stmt_info);
+
+	ifxPrepareParamsForScan(planState->state, planState->coninfo);
+	elog(DEBUG2, "informix_fdw: regenerated remote query \"%s\"",
+		 planState->state->stmt_info.query);
+}
+
+static ForeignScan *ifxGetForeignPlan(PlannerInfo *root,
+									  RelOptInfo *baserel,
+									  Oid foreignTableId,
+									  ForeignPath *best_path,
+									  List *tlist,
+									  List *scan_clauses
+#if PG_VERSION_NUM >= 90500
+									  , Plan *outer_plan
+#endif
+	)
+{
+	Index scan_relid;
+	IfxFdwPlanState  *planState;
+	List             *plan_values;
+	List             *param_exprs;
+	List             *local_clauses = NIL;
+	List             *pushed_join_clauses = NIL;
+	ListCell         *cell;
+	bool              regenerate = false;
+
+	elog(DEBUG3, "informix_fdw: get foreign plan");
+
+#if PG_VERSION_NUM >= 90500
+	/*
+	 * Pushed down join or aggregation, the remote query was
+	 * already generated by ifxGetForeignJoinPaths() or
+	 * ifxGetForeignUpperPaths().
+	 *
+	 * Foreign tables scanned as inheritance children or partitions
+	 * (RELOPT_OTHER_MEMBER_REL) are plain scans, too.
+	 */
+	if ((baserel->reloptkind == RELOPT_JOINREL)
+#if PG_VERSION_NUM >= 90600
+		|| (baserel->reloptkind == RELOPT_UPPER_REL)
+#endif
+		)
+		return ifxGetForeignRemotePlan(root, baserel, tlist);
+#endif
+
+	scan_relid = baserel->relid;
+	planState = (IfxFdwPlanState *) baserel->fdw_private;
+
+	param_exprs = list_copy(planState->param_exprs);
+
+	/*
+	 * If the choosen path requests sorted or restricted output, we need to
+	 * push down the ORDER BY clause and LIMIT formerly examined by
+	 * ifxGetForeignPaths().
+	 */
+	if (best_path->fdw_private != NIL)
+	{
+		char *sort_clause;
+
+		sort_clause = strVal(list_nth(best_path->fdw_private,
+									  IFX_PATH_PRIVATE_SORT_CLAUSE));
+
+		planState->state->sort_clause = (strlen(sort_clause) > 0) ? sort_clause : NULL;
+		planState->state->limit_count = intVal(list_nth(best_path->fdw_private,
+														IFX_PATH_PRIVATE_LIMIT_COUNT));
+		regenerate = true;
+	}
+
+#if PG_VERSION_NUM >= 90300
+	/*
+	 * A parameterized path pushes down its join clauses with the
+	 * values of the outer relation bound to placeholders, see
+	 * ifxAddForeignParamPaths(). The planner replaces the outer
+	 * references within fdw_exprs with executor parameters.
+	 */
+	if (best_path->path.param_info != NULL)
+	{
+		ifxPushdownParamJoinClauses(planState, baserel,
+									best_path->path.param_info->ppi_clauses,
+									&pushed_join_clauses,
+									&param_exprs);
+		regenerate = true;
+	}
+#endif
+
+	/*
+	 * In case we are allowed to push down query predicates, ifxFilterQuals()
+	 * would have filtered out all remote scan clauses and we need to
+	 * examine all excluded clauses only. scan_clauses carries the join
+	 * clauses of a parameterized path, too, only those not pushed
+	 * down above are checked locally.
+	 *
+	 * NOTE: ifxFilterQuals() won't be called in case predicate_pushdown is
+	 *       disabled. In this case we don't filter at all so pass all
+	 *       scan claususes "as-is" but with all pseudoconstants filtered.
+	 */
+	if (planState->coninfo->predicate_pushdown)
+	{
+		foreach(cell, scan_clauses)
+		{
+			RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+
+			if (rinfo->pseudoconstant)
+				continue;
+
+			if (list_member_ptr(baserel->baserestrictinfo, rinfo)
+				? list_member_ptr(planState->excl_restrictInfo, rinfo)
+				: !list_member_ptr(pushed_join_clauses, rinfo))
+				local_clauses = lappend(local_clauses, rinfo->clause);
+		}
+	}
+	else
+		local_clauses = extract_actual_clauses(scan_clauses, false);
+
+	if (regenerate)
+		ifxRegenerateScanQuery(planState);
+
+	/*
+	 * The arrays loaded into key tables are passed after the
+	 * placeholder values, see ifxBeginForeignScan().
+	 */
+	foreach(cell, planState->key_sets)
+		param_exprs = lappend(param_exprs, ((IfxKeySet *) lfirst(cell))->expr);
+
+	/*
+	 * Serialize current plan data into a format suitable
+	 * for copyObject() later. This is required to be able to
+	 * push down the collected information here down to the
+	 * executor.
+	 */
+	plan_values = ifxSerializePlanData(planState->coninfo,
+									   planState->state,
+									   root);
+
+	return IFX_MAKE_FOREIGNSCAN(tlist,
+								local_clauses,
+								scan_relid,
+								param_exprs,
+								plan_values,
+								NIL);
+}
+
+#if PG_VERSION_NUM >= 90600
+
+/*
+ * ifxGetForeignUpperPaths
+ *
+ * Adds foreign paths for post-scan/join processing (e.g. aggregation)
+ * performed on the remote Informix server.
+ */
+static void ifxGetForeignUpperPaths(PlannerInfo *root,
+									UpperRelationKind stage,
+									RelOptInfo *input_rel,
+									RelOptInfo *output_rel
+#if PG_VERSION_NUM >= 110000
+									, void *extra
+#endif
+	)
+{
+	elog(DEBUG3, "informix_fdw: get foreign upper paths, stage %d", stage);
+
+	/*
+	 * The input relation must be a foreign relation planned
+	 * by us, and we don't want to do the work twice.
+	 */
+	if ((input_rel->fdw_private == NULL)
+		|| (output_rel->fdw_private != NULL))
+		return;
+
+	switch (stage)
+	{
+		case UPPERREL_GROUP_AGG:
+			ifxAddForeignGroupingPath(root, input_rel, output_rel);
+			break;
+		case UPPERREL_DISTINCT:
+			ifxAddForeignDistinctPath(root, input_rel, output_rel);
+			break;
+		default:
+			/* not supported */
+			break;
+	}
+}
+
+/*
+ * Returns the deparse information for the input relation of an
+ * upper relation, or NIL in case the input relation can't be the
+ * source of a remote aggregation or DISTINCT query.
+ *
+ * We support a plain foreign table only, all restriction clauses
+ * must be pushed down as well. Placeholders in the pushed down
+ * restrictions aren't supported yet, since we don't bind values
+ * to remote upper queries. Column references are deparsed without
+ * any table alias.
+ */
+static List *ifxGetUpperRelInfos(RelOptInfo *input_rel,
+								 IfxFdwPlanState *inputState)
+{
+	IfxDeparseRelInfo *relinfo;
+
+	if ((input_rel->reloptkind != RELOPT_BASEREL)
+		|| (inputState->coninfo->query != NULL)
+		|| (inputState->state->stmt_info.cursorUsage == IFX_UPDATE_CURSOR)
+		|| (inputState->param_exprs != NIL)
+		|| (inputState->key_sets != NIL)
+		|| ifxHasLocalQuals(input_rel, inputState))
+		return NIL;
+
+	relinfo = palloc(sizeof(IfxDeparseRelInfo));
+	relinfo->rtid         = input_rel->relid;
+	relinfo->foreignRelid = inputState->foreignTableOid;
+	relinfo->alias        = NULL;
+	relinfo->shippable_funcs
+		= ifxParseShippableFunctions(inputState->coninfo->pushdown_functions);
+
+	return list_make1(relinfo);
+}
+
+/*
+ * Appends the FROM clause of a remote upper query to buf, including
+ * the predicate already pushed down for the input relation.
+ */
+static void ifxAppendUpperFromClause(StringInfo buf,
+									 IfxFdwPlanState *inputState)
+{
+	appendStringInfo(buf, " FROM %s", inputState->coninfo->tablename);
+
+	if ((inputState->state->stmt_info.predicate != NULL)
+		&& (strlen(inputState->state->stmt_info.predicate) > 0)
+		&& inputState->coninfo->predicate_pushdown)
+	{
+		appendStringInfo(buf, " WHERE %s",
+						 inputState->state->stmt_info.predicate);
+	}
+}
+
+/*
+ * Creates a copy of the execution state of the input relation,
+ * carrying the specified remote query and the target list describing
+ * the tuples it returns. The statement identifiers are reused, see
+ * ifxGetForeignRemotePlan() for details.
+ */
+static IfxFdwPlanState *ifxCopyUpperPlanState(IfxFdwPlanState *inputState,
+											  char *query,
+											  List *tlist)
+{
+	IfxFdwPlanState *planState;
+
+	planState = palloc0(sizeof(IfxFdwPlanState));
+	planState->coninfo = inputState->coninfo;
+	planState->state   = palloc(sizeof(IfxFdwExecutionState));
+	memcpy(planState->state, inputState->state, sizeof(IfxFdwExecutionState));
+
+	planState->state->stmt_info.query      = query;
+	planState->state->stmt_info.call_stack = IFX_STACK_EMPTY;
+	planState->state->use_rowid            = false;
+	planState->state->sort_clause          = NULL;
+	planState->state->limit_count          = 0;
+	planState->foreignTableOid             = inputState->foreignTableOid;
+	planState->excl_restrictInfo           = NIL;
+	planState->scan_tlist                  = tlist;
+	planState->input_states                = list_make1(inputState->state);
+
+	return planState;
+}
+
+/*
+ * Adds a foreign path to the specified grouped relation in case
+ * all aggregates, GROUP BY and HAVING clauses can be evaluated on
+ * the Informix server.
+ *
+ * The remote query is generated immediately and saved within a new
+ * IfxFdwPlanState attached to the grouped relation, together with the
+ * target list describing the tuples returned by the remote query.
+ */
+static void ifxAddForeignGroupingPath(PlannerInfo *root,
+									  RelOptInfo *input_rel,
+									  RelOptInfo *grouped_rel)
+{
+	IfxFdwPlanState      *inputState;
+	IfxFdwPlanState      *planState;
+	Query                *parse = root->parse;
+	PathTarget           *grouping_target;
+	List                 *tlist = NIL;
+	List                 *group_list = NIL;
+	List                 *having_list = NIL;
+	ListCell             *cell;
+	StringInfoData        buf;
+	double                rows;
+	Cost                  startup_cost;
+	Cost                  total_cost;
+	int                   i;
+	List                 *relinfos;
+
+	inputState = (IfxFdwPlanState *) input_rel->fdw_private;
+
+	relinfos = ifxGetUpperRelInfos(input_rel, inputState);
+
+	if (relinfos == NIL)
+		return;
+
+	/* Informix doesn't know about grouping sets */
+	if (parse->groupingSets != NIL)
+		return;
+
+	grouping_target = root->upper_targets[UPPERREL_GROUP_AGG];
+
+	/*
+	 * Examine the grouping target. Grouping expressions must be
+	 * plain column references, all other expressions must be either
+	 * supported aggregates or expressions built on top of them. In the
+	 * latter case only the aggregates are evaluated remotely.
+	 */
+	i = 0;
+	foreach(cell, grouping_target->exprs)
+	{
+		Expr  *expr  = (Expr *) lfirst(cell);
+		Index  sgref = get_pathtarget_sortgroupref(grouping_target, i);
+		char  *deparsed;
+
+		i++;
+
+		if ((sgref != 0)
+			&& (get_sortgroupref_clause_noerr(sgref, parse->groupClause) != NULL))
+		{
+			TargetEntry *tle;
+
+			if (!IsA(expr, Var))
+				return;
+
+			deparsed = ifxDeparseRemoteExpr((Node *) expr, relinfos, NULL);
+
+			if (deparsed == NULL)
+				return;
+
+			tle = makeTargetEntry(expr, list_length(tlist) + 1, NULL, false);
+			tle->ressortgroupref = sgref;
+			tlist = lappend(tlist, tle);
+			group_list = lappend(group_list, deparsed);
+		}
+		else if (IsA(expr, Aggref))
+		{
+			if (ifxDeparseRemoteExpr((Node *) expr, relinfos, NULL) == NULL)
+				return;
+
+			tlist = add_to_flat_tlist(tlist, list_make1(expr));
+		}
+		else
+		{
+			List     *aggs;
+			ListCell *agg_cell;
+
+			aggs = pull_var_clause((Node *) expr, PVC_INCLUDE_AGGREGATES);
+
+			foreach(agg_cell, aggs)
+			{
+				Node *agg = (Node *) lfirst(agg_cell);
+
+				/*
+				 * Plain column references must be grouping
+				 * columns already part of the target list.
+				 */
+				if (IsA(agg, Var))
+				{
+					if (tlist_member(agg, tlist) == NULL)
+						return;
+
+					continue;
+				}
+
+				if (!IsA(agg, Aggref)
+					|| (ifxDeparseRemoteExpr(agg, relinfos, NULL) == NULL))
+					return;
+
+				tlist = add_to_flat_tlist(tlist, list_make1(agg));
+			}
+		}
+	}
+
+	/* nothing to fetch from the remote server */
+	if (tlist == NIL)
+		return;
+
+	/*
+	 * The HAVING clause must be evaluated remotely as a whole.
+	 */
+	if (parse->havingQual != NULL)
+	{
+		foreach(cell, (List *) parse->havingQual)
+		{
+			char *deparsed;
+
+			deparsed = ifxDeparseRemoteExpr((Node *) lfirst(cell), relinfos, NULL);
+
+			if (deparsed == NULL)
+				return;
+
+			having_list = lappend(having_list, deparsed);
+		}
+	}
+
+	/*
+	 * Looks good, generate the remote query.
+	 */
+	initStringInfo(&buf);
+	appendStringInfoString(&buf, "SELECT ");
+
+	foreach(cell, tlist)
+	{
+		TargetEntry *tle = (TargetEntry *) lfirst(cell);
+
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(tlist)) ? "" : ", ",
+						 ifxDeparseRemoteExpr((Node *) tle->expr, relinfos, NULL));
+	}
+
+	ifxAppendUpperFromClause(&buf, inputState);
+
+	foreach(cell, group_list)
+	{
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(group_list)) ? " GROUP BY " : ", ",
+						 (char *) lfirst(cell));
+	}
+
+	foreach(cell, having_list)
+	{
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(having_list)) ? " HAVING " : " AND ",
+						 (char *) lfirst(cell));
+	}
+
+	/*
+	 * Estimate the number of groups. The Informix server needs to
+	 * read all input rows before returning the first group, but we
+	 * transfer the groups only.
+	 */
+	if (parse->groupClause != NIL)
+		rows = estimate_num_groups(root,
+								   get_sortgrouplist_exprs(parse->groupClause,
+														   tlist),
+								   input_rel->rows,
+								   NULL);
+	else
+		rows = 1;
+
+	startup_cost = inputState->coninfo->planData.costs
+		+ (input_rel->rows * cpu_operator_cost);
+	total_cost   = startup_cost + (rows * cpu_tuple_cost);
+
+	planState = ifxCopyUpperPlanState(inputState, buf.data, tlist);
+
+	elog(DEBUG2, "informix_fdw: remote grouping query \"%s\"", buf.data);
+
+	grouped_rel->fdw_private = (void *) planState;
+
+	add_path(grouped_rel, (Path *)
+			 IFX_CREATE_FOREIGNSCAN_PATH(root, grouped_rel,
+										 grouping_target,
+										 rows,
+										 startup_cost,
+										 total_cost,
+										 NIL,
+										 NIL));
+}
+
+/*
+ * Adds a foreign path to the specified distinct relation in case
+ * duplicate elimination of a SELECT DISTINCT can be done by the
+ * Informix server.
+ *
+ * Like ifxAddForeignGroupingPath(), the remote query is generated
+ * immediately and saved within a new IfxFdwPlanState attached to
+ * the distinct relation.
+ */
+static void ifxAddForeignDistinctPath(PlannerInfo *root,
+									  RelOptInfo *input_rel,
+									  RelOptInfo *distinct_rel)
+{
+	IfxFdwPlanState      *inputState;
+	IfxFdwPlanState      *planState;
+	Query                *parse = root->parse;
+	PathTarget           *distinct_target;
+	List                 *tlist = NIL;
+	List                 *deparsed_list = NIL;
+	ListCell             *cell;
+	ListCell             *deparsed_cell;
+	StringInfoData        buf;
+	double                rows;
+	Cost                  startup_cost;
+	Cost                  total_cost;
+	int                   i;
+	List                 *relinfos;
+
+	inputState = (IfxFdwPlanState *) input_rel->fdw_private;
+
+	relinfos = ifxGetUpperRelInfos(input_rel, inputState);
+
+	if (relinfos == NIL)
+		return;
+
+	/* DISTINCT ON isn't supported by Informix */
+	if (parse->hasDistinctOn
+		|| parse->hasAggs
+		|| parse->hasWindowFuncs
+		|| (parse->groupClause != NIL)
+		|| (parse->havingQual != NULL))
+		return;
+
+	/*
+	 * Without window functions, this is the target list
+	 * the DISTINCT clause is applied to.
+	 */
+	distinct_target = root->upper_targets[UPPERREL_WINDOW];
+
+	/*
+	 * Every output expression must be a DISTINCT key which can be
+	 * evaluated remotely and whose type has the same equality
+	 * semantics on both sides.
+	 */
+	i = 0;
+	foreach(cell, distinct_target->exprs)
+	{
+		Expr        *expr  = (Expr *) lfirst(cell);
+		Index        sgref = get_pathtarget_sortgroupref(distinct_target, i);
+		TargetEntry *tle;
+		char        *deparsed;
+
+		i++;
+
+		if ((sgref == 0)
+			|| (get_sortgroupref_clause_noerr(sgref, parse->distinctClause) == NULL))
+			return;
+
+		if (!ifxIsCompatibleForEquality(exprType((Node *) expr)))
+			return;
+
+		deparsed = ifxDeparseRemoteExpr((Node *) expr, relinfos, NULL);
+
+		if (deparsed == NULL)
+			return;
+
+		tle = makeTargetEntry(expr, list_length(tlist) + 1, NULL, false);
+		tle->ressortgroupref = sgref;
+		tlist = lappend(tlist, tle);
+		deparsed_list = lappend(deparsed_list, deparsed);
+	}
+
+	/* nothing to fetch from the remote server */
+	if (tlist == NIL)
+		return;
+
+	/*
+	 * Looks good, generate the remote query.
+	 */
+	initStringInfo(&buf);
+	appendStringInfoString(&buf, "SELECT DISTINCT ");
+
+	foreach(deparsed_cell, deparsed_list)
+	{
+		appendStringInfo(&buf, "%s%s",
+						 (deparsed_cell == list_head(deparsed_list)) ? "" : ", ",
+						 (char *) lfirst(deparsed_cell));
+	}
+
+	ifxAppendUpperFromClause(&buf, inputState);
+
+	/*
+	 * The Informix server needs to read all input rows before
+	 * returning the first distinct row, but we transfer the
+	 * distinct rows only.
+	 */
+	rows = estimate_num_groups(root,
+							   get_sortgrouplist_exprs(parse->distinctClause,
+													   tlist),
+							   input_rel->rows,
+							   NULL);
+
+	startup_cost = inputState->coninfo->planData.costs
+		+ (input_rel->rows * cpu_operator_cost);
+	total_cost   = startup_cost + (rows * cpu_tuple_cost);
+
+	planState = ifxCopyUpperPlanState(inputState, buf.data, tlist);
+
+	elog(DEBUG2, "informix_fdw: remote distinct query \"%s\"", buf.data);
+
+	distinct_rel->fdw_private = (void *) planState;
+
+	add_path(distinct_rel, (Path *)
+			 IFX_CREATE_FOREIGNSCAN_PATH(root, distinct_rel,
+										 distinct_target,
+										 rows,
+										 startup_cost,
+										 total_cost,
+										 NIL,
+										 NIL));
+}
+
+#endif
+
+#if PG_VERSION_NUM >= 90500
+
+/*
+ * ifxGetForeignJoinPaths
+ *
+ * Adds a foreign path for a join between two foreign tables
+ * evaluated on the remote Informix server.
+ *
+ * This is possible only if both foreign tables are scanned via the
+ * same Informix connection, all join clauses and all restrictions on
+ * both tables can be pushed down. We currently support joins between
+ * plain foreign tables only, no join relations as input.
+ */
+static void ifxGetForeignJoinPaths(PlannerInfo *root,
+								   RelOptInfo *joinrel,
+								   RelOptInfo *outerrel,
+								   RelOptInfo *innerrel,
+								   JoinType jointype,
+								   JoinPathExtraData *extra)
+{
+	IfxFdwPlanState      *outerState;
+	IfxFdwPlanState      *innerState;
+	IfxFdwPlanState      *planState;
+	IfxConnectionInfo    *coninfo;
+	IfxFdwExecutionState *state;
+	IfxCachedConnection  *cached;
+	IfxDeparseRelInfo    *outerInfo;
+	IfxDeparseRelInfo    *innerInfo;
+	List                 *relinfos;
+	List                 *tlist = NIL;
+	List                 *join_conds = NIL;
+	List                 *where_conds = NIL;
+	List                 *outer_conds;
+	List                 *inner_conds;
+	ListCell             *cell;
+	StringInfoData        buf;
+	char                 *jointype_str;
+	Cost                  startup_cost;
+	Cost                  total_cost;
+
+	elog(DEBUG3, "informix_fdw: get foreign join paths, jointype %d", jointype);
+
+	/*
+	 * We get called for every join order of the same join
+	 * relation, but examine it only once. A join relation not
+	 * suitable for pushdown gets an empty plan state.
+	 */
+	if (joinrel->fdw_private != NULL)
+		return;
+
+	planState = palloc0(sizeof(IfxFdwPlanState));
+	joinrel->fdw_private = (void *) planState;
+
+	/*
+	 * We don't bother with EvalPlanQual rechecks, so restrict
+	 * join pushdown to plain SELECTs without row marks.
+	 */
+	if ((root->parse->commandType != CMD_SELECT)
+		|| (root->rowMarks != NIL))
+		return;
+
+	switch (jointype)
+	{
+		case JOIN_INNER:
+			jointype_str = "INNER JOIN";
+			break;
+		case JOIN_LEFT:
+			jointype_str = "LEFT OUTER JOIN";
+			break;
+		case JOIN_RIGHT:
+			jointype_str = "RIGHT OUTER JOIN";
+			break;
+		case JOIN_FULL:
+			jointype_str = "FULL OUTER JOIN";
+			break;
+		default:
+			/* SEMI and ANTI joins are not supported */
+			return;
+	}
+
+	if ((outerrel->reloptkind != RELOPT_BASEREL)
+		|| (innerrel->reloptkind != RELOPT_BASEREL))
+		return;
+
+	outerState = (IfxFdwPlanState *) outerrel->fdw_private;
+	innerState = (IfxFdwPlanState *) innerrel->fdw_private;
+
+	if ((outerState == NULL) || (innerState == NULL))
+		return;
+
+	/*
+	 * Both foreign tables must be plain tables with predicate
+	 * pushdown enabled, living on the same Informix server and
+	 * accessed with the same credentials.
+	 */
+	if ((outerState->coninfo->query != NULL)
+		|| (innerState->coninfo->query != NULL)
+		|| !outerState->coninfo->predicate_pushdown
+		|| !innerState->coninfo->predicate_pushdown)
+		return;
+
+	if (strcmp(outerState->coninfo->conname, innerState->coninfo->conname) != 0)
+		return;
+
+	outerInfo = palloc(sizeof(IfxDeparseRelInfo));
+	outerInfo->rtid         = outerrel->relid;
+	outerInfo->foreignRelid = outerState->foreignTableOid;
+	outerInfo->alias        = psprintf("r%d", outerrel->relid);
+	outerInfo->shippable_funcs
+		= ifxParseShippableFunctions(outerState->coninfo->pushdown_functions);
+
+	innerInfo = palloc(sizeof(IfxDeparseRelInfo));
+	innerInfo->rtid         = innerrel->relid;
+	innerInfo->foreignRelid = innerState->foreignTableOid;
+	innerInfo->alias        = psprintf("r%d", innerrel->relid);
+	innerInfo->shippable_funcs
+		= ifxParseShippableFunctions(innerState->coninfo->pushdown_functions);
+
+	relinfos = list_make2(outerInfo, innerInfo);
+
+	/*
+	 * Deparse the restrictions of both foreign tables. We don't
+	 * reuse the predicates generated by ifxFilterQuals() here, since
+	 * column references need to be qualified within a join.
+	 */
+	outer_conds = NIL;
+	foreach(cell, outerrel->baserestrictinfo)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+		char         *deparsed;
+
+		if ((deparsed = ifxDeparseRemoteExpr((Node *) rinfo->clause, relinfos, NULL)) == NULL)
+			return;
+
+		outer_conds = lappend(outer_conds, deparsed);
+	}
+
+	inner_conds = NIL;
+	foreach(cell, innerrel->baserestrictinfo)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+		char         *deparsed;
+
+		if ((deparsed = ifxDeparseRemoteExpr((Node *) rinfo->clause, relinfos, NULL)) == NULL)
+			return;
+
+		inner_conds = lappend(inner_conds, deparsed);
+	}
+
+	/*
+	 * Restrictions of the nullable side of an outer join must be
+	 * applied before the join, thus go into the ON clause. We can't
+	 * place restrictions of a FULL OUTER JOIN correctly without
+	 * using derived tables, so give up in this case.
+	 */
+	switch (jointype)
+	{
+		case JOIN_INNER:
+			where_conds = list_concat(outer_conds, inner_conds);
+			break;
+		case JOIN_LEFT:
+			where_conds = outer_conds;
+			join_conds  = inner_conds;
+			break;
+		case JOIN_RIGHT:
+			join_conds  = outer_conds;
+			where_conds = inner_conds;
+			break;
+		default:
+			if ((outer_conds != NIL) || (inner_conds != NIL))
+				return;
+			break;
+	}
+
+	/*
+	 * Deparse the join clauses. Clauses pushed down to an outer
+	 * join are applied to the join result.
+	 */
+	foreach(cell, extra->restrictlist)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(cell);
+		char         *deparsed;
+
+		if ((deparsed = ifxDeparseRemoteExpr((Node *) rinfo->clause, relinfos, NULL)) == NULL)
+			return;
+
+		if (IS_OUTER_JOIN(jointype) && rinfo->is_pushed_down)
+			where_conds = lappend(where_conds, deparsed);
+		else
+			join_conds = lappend(join_conds, deparsed);
+	}
+
+	/*
+	 * Build the target list of the remote query. We support plain
+	 * column references only.
+	 */
+	foreach(cell, IFX_REL_TARGET_EXPRS(joinrel))
+	{
+		Node *node = (Node *) lfirst(cell);
+
+		if (!IsA(node, Var)
+			|| (ifxDeparseRemoteExpr(node, relinfos, NULL) == NULL))
+			return;
+
+		tlist = add_to_flat_tlist(tlist, list_make1(node));
+	}
+
+	/*
+	 * If no columns are required, e.g. for a COUNT(*) above the
+	 * join, we still need to return a column for each row.
+	 */
+	if (tlist == NIL)
+		tlist = lappend(tlist,
+						makeTargetEntry((Expr *) makeConst(INT4OID, -1, InvalidOid,
+														   sizeof(int32),
+														   Int32GetDatum(1),
+														   false, true),
+										1, NULL, false));
+
+	/*
+	 * Looks good, generate the remote query.
+	 */
+	initStringInfo(&buf);
+	appendStringInfoString(&buf, "SELECT ");
+
+	foreach(cell, tlist)
+	{
+		TargetEntry *tle = (TargetEntry *) lfirst(cell);
+
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(tlist)) ? "" : ", ",
+						 ifxDeparseRemoteExpr((Node *) tle->expr, relinfos, NULL));
+	}
+
+	appendStringInfo(&buf, " FROM %s %s %s %s %s ON ",
+					 outerState->coninfo->tablename, outerInfo->alias,
+					 jointype_str,
+					 innerState->coninfo->tablename, innerInfo->alias);
+
+	/* Informix requires a join condition */
+	if (join_conds == NIL)
+		appendStringInfoString(&buf, "1 = 1");
+
+	foreach(cell, join_conds)
+	{
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(join_conds)) ? "" : " AND ",
+						 (char *) lfirst(cell));
+	}
+
+	foreach(cell, where_conds)
+	{
+		appendStringInfo(&buf, "%s%s",
+						 (cell == list_head(where_conds)) ? " WHERE " : " AND ",
+						 (char *) lfirst(cell));
+	}
+
+	elog(DEBUG2, "informix_fdw: remote join query \"%s\"", buf.data);
+
+	/*
+	 * Prepare the join query on the Informix server to get its
+	 * cost estimates, just like ifxGetForeignRelSize() does for
+	 * a single foreign table. We need a new refid to get
+	 * statement identifiers not used by the foreign tables, so
+	 * use IFX_PLAN_SCAN here.
+	 *
+	 * The statement is released immediately, ifxBeginForeignScan()
+	 * prepares it again if this path gets choosen.
+	 */
+	cached = ifxSetupConnection(&coninfo, outerState->foreignTableOid,
+								IFX_PLAN_SCAN, true);
+
+	state = makeIfxFdwExecutionState(cached->con.usage);
+	state->foreignTableOid  = outerState->foreignTableOid;
+	state->use_rowid        = false;
+	state->stmt_info.query  = buf.data;
+	StrNCpy(state->stmt_info.conname, coninfo->conname, IFX_CONNAME_LEN);
+
+	ifxPrepareCursorForScan(&state->stmt_info, coninfo);
+
+	coninfo->planData.estimated_rows = (double) ifxGetSQLCAErrd(SQLCA_NROWS_PROCESSED);
+	coninfo->planData.costs          = (double) ifxGetSQLCAErrd(SQLCA_NROWS_WEIGHT);
+
+	ifxRewindCallstack(&state->stmt_info);
+
+	/*
+	 * The number of rows of the join relation was already estimated
+	 * by the planner, we just use the costs reported by Informix.
+	 */
+	startup_cost = coninfo->planData.costs;
+	total_cost   = startup_cost + (joinrel->rows * cpu_tuple_cost);
+
+	coninfo->planData.total_costs = total_cost;
+
+	planState->coninfo           = coninfo;
+	planState->state             = state;
+	planState->foreignTableOid   = outerState->foreignTableOid;
+	planState->excl_restrictInfo = NIL;
+	planState->scan_tlist        = tlist;
+	planState->input_states      = list_make2(outerState->state,
+											  innerState->state);
+
+	add_path(joinrel, (Path *)
+			 IFX_CREATE_FOREIGNSCAN_PATH(root, joinrel,
+										 NULL,
+										 joinrel->rows,
+										 startup_cost,
+										 total_cost,
+										 NIL,
+										 NIL));
+}
+
+/*
+ * Creates the ForeignScan plan node for a pushed down
+ * join or upper relation.
+ */
+static ForeignScan *ifxGetForeignRemotePlan(PlannerInfo *root,
+											RelOptInfo *rel,
+											List *tlist)
+{
+	IfxFdwPlanState *planState;
+	List            *plan_values;
+	ListCell        *cell;
+
+	planState = (IfxFdwPlanState *) rel->fdw_private;
 
 	/*
-	 * Serialize current plan data into a format suitable
-	 * for copyObject() later. This is required to be able to
-	 * push down the collected information here down to the
-	 * executor.
+	 * The statements prepared for the input relations during
+	 * ifxGetForeignRelSize() aren't used anymore, release them.
+	 * The remote query will be prepared by ifxBeginForeignScan(),
+	 * possibly reusing the same statement identifiers.
 	 */
+	ifxSetConnection(planState->coninfo);
+
+	foreach(cell, planState->input_states)
+	{
+		IfxFdwExecutionState *input_state = (IfxFdwExecutionState *) lfirst(cell);
+
+		ifxRewindCallstack(&input_state->stmt_info);
+	}
+
 	plan_values = ifxSerializePlanData(planState->coninfo,
 									   planState->state,
 									   root);
 
-	return make_foreignscan(tlist,
-							scan_clauses,
-							scan_relid,
-							NIL,
-							plan_values);
+	/*
+	 * All expressions are evaluated remotely, so there aren't any
+	 * quals left to be checked locally.
+	 */
+	return IFX_MAKE_FOREIGNSCAN(tlist,
+								NIL,
+								0,
+								NIL,
+								plan_values,
+								planState->scan_tlist);
 }
 
+#endif
+
 #else
 
 /*
@@ -2652,6 +5923,11 @@ ifxPlanForeignScan(Oid foreignTableOid, PlannerInfo *planInfo, RelOptInfo *baser
 	ifxSetupFdwScan(&coninfo, &state, &plan_values,
 					foreignTableOid, IFX_PLAN_SCAN);
 
+	/* see ifxGetForeignRelSize() */
+	if ((coninfo->query != NULL)
+		&& !ifxQueryAllowsDerivedTable(coninfo))
+		coninfo->predicate_pushdown = 0;
+
 	/*
 	 * Check for predicates that can be pushed down
 	 * to the informix server, but skip it in case the user
@@ -2661,7 +5937,9 @@ ifxPlanForeignScan(Oid foreignTableOid, PlannerInfo *planInfo, RelOptInfo *baser
 	{
 		state->stmt_info.predicate = ifxFilterQuals(planInfo, baserel,
 													&excl_restrictInfo,
-													foreignTableOid);
+													foreignTableOid, coninfo,
+													NULL, NULL,
+													state->stmt_info.refid);
 		elog(DEBUG2, "predicate for pushdown: %s", state->stmt_info.predicate);
 	}
 	else
@@ -2932,9 +6210,13 @@ static void ifxPgColumnData(Oid foreignTableOid, IfxFdwExecutionState *festate)
 		++pgAttrIndex;
 
 		/*
-		 * Ignore dropped columns.
+		 * Ignore dropped columns. Columns not retrieved from
+		 * the remote table (see projected_attrs) are treated the
+		 * same way, they are always NULL.
 		 */
-		if (attrTuple->attisdropped)
+		if (attrTuple->attisdropped
+			|| ((festate->projected_attrs != NULL)
+				&& !bms_is_member(attrTuple->attnum, festate->projected_attrs)))
 		{
 			festate->pgAttrDefs[pgAttrIndex - 1].attnum = -1;
 
@@ -3009,6 +6291,67 @@ static void ifxPgColumnData(Oid foreignTableOid, IfxFdwExecutionState *festate)
 	heap_close(attrRel, AccessShareLock);
 }
 
+#if PG_VERSION_NUM >= 90500
+
+/*
+ * Retrieve the column definition of the tuples returned
+ * by a foreign scan without a scan relation. The remote query
+ * returns the columns in the order of the specified
+ * tuple descriptor.
+ */
+static void ifxPgColumnDataFromTupleDesc(TupleDesc tupdesc,
+										 IfxFdwExecutionState *festate)
+{
+	int i;
+
+	festate->pgAttrCount        = tupdesc->natts;
+	festate->pgDroppedAttrCount = 0;
+
+	/* never retrieve a ROWID here */
+	festate->use_rowid = false;
+
+	festate->pgAttrDefs = palloc0fast(sizeof(PgAttrDef) * IFX_PGATTRCOUNT(festate));
+
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+
+		festate->pgAttrDefs[i].attnum     = i + 1;
+		festate->pgAttrDefs[i].ifx_attnum = i + 1;
+		festate->pgAttrDefs[i].param_id   = -1;
+		festate->pgAttrDefs[i].atttypid   = attr->atttypid;
+		festate->pgAttrDefs[i].atttypmod  = attr->atttypmod;
+		festate->pgAttrDefs[i].attname    = pstrdup(NameStr(attr->attname));
+		festate->pgAttrDefs[i].attnotnull = false;
+	}
+}
+
+#endif
+
+/*
+ * Returns the value of the batch_size option. Errors out
+ * in case it isn't a positive integer.
+ */
+static int
+ifxGetBatchSizeOption(DefElem *def)
+{
+	char *value = defGetString(def);
+	char *endptr;
+	long  batch_size;
+
+	errno = 0;
+	batch_size = strtol(value, &endptr, 10);
+
+	if ((errno != 0) || (endptr == value) || (*endptr != '\0')
+		|| (batch_size <= 0) || (batch_size > INT_MAX))
+		ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_ATTRIBUTE_VALUE),
+						errmsg("invalid value for option batch_size: \"%s\"",
+							   value),
+						errhint("batch_size requires a positive integer value")));
+
+	return (int) batch_size;
+}
+
 /*
  * Checks for duplicate and redundant options.
  *
@@ -3154,6 +6497,28 @@ ifxGetOptionDups(IfxConnectionInfo *coninfo, DefElem *def)
 		coninfo->tablename = defGetString(def);
 	}
 
+	if (strcmp(def->defname, "pushdown_functions") == 0)
+	{
+		if (coninfo->pushdown_functions)
+			ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_OPTION_NAME),
+							errmsg("conflicting or redundant options: pushdown_functions(%s)",
+								   defGetString(def))));
+
+		if (ifxParseShippableFunctions(defGetString(def)) == NIL)
+			ereport(ERROR, (errcode(ERRCODE_FDW_INVALID_ATTRIBUTE_VALUE),
+							errmsg("invalid value for option pushdown_functions: \"%s\"",
+								   defGetString(def)),
+							errhint("specify a comma separated list of function names")));
+
+		coninfo->pushdown_functions = defGetString(def);
+	}
+
+	if (strcmp(def->defname, "batch_size") == 0)
+	{
+		/* errors out on invalid values */
+		coninfo->batch_size = ifxGetBatchSizeOption(def);
+	}
+
 }
 
 /*
@@ -3215,6 +6580,24 @@ ifx_fdw_handler(PG_FUNCTION_ARGS)
 
 	#endif
 
+	/*
+	 * Since PostgreSQL 9.5 we can push down joins...
+	 */
+	#if PG_VERSION_NUM >= 90500
+
+	fdwRoutine->GetForeignJoinPaths = ifxGetForeignJoinPaths;
+
+	#endif
+
+	/*
+	 * ...and since PostgreSQL 9.6 aggregation, too.
+	 */
+	#if PG_VERSION_NUM >= 90600
+
+	fdwRoutine->GetForeignUpperPaths = ifxGetForeignUpperPaths;
+
+	#endif
+
 	/*
 	 * Since PostgreSQL 9.3 we support updatable foreign tables.
 	 */
@@ -3232,6 +6615,20 @@ ifx_fdw_handler(PG_FUNCTION_ARGS)
 
 	#endif
 
+	/*
+	 * UPDATE and DELETE are executed as a single remote
+	 * statement since PostgreSQL 9.6, if possible.
+	 */
+	#if PG_VERSION_NUM >= 90600
+
+	fdwRoutine->PlanDirectModify    = ifxPlanDirectModify;
+	fdwRoutine->BeginDirectModify   = ifxBeginDirectModify;
+	fdwRoutine->IterateDirectModify = ifxIterateDirectModify;
+	fdwRoutine->EndDirectModify     = ifxEndDirectModify;
+	fdwRoutine->ExplainDirectModify = ifxExplainDirectModify;
+
+	#endif
+
 	PG_RETURN_POINTER(fdwRoutine);
 }
 
@@ -3248,6 +6645,17 @@ static void ifxReScanForeignScan(ForeignScanState *state)
 
 	elog(DEBUG1, "informix_fdw: rescan");
 
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * The values bound to the placeholders of a parameterized
+	 * scan have changed. ifxFetchTuple() reopens the cursor with
+	 * the new values.
+	 */
+	if ((fdw_state->param_exprs != NIL)
+		&& (state->ss.ps.chgParam != NULL))
+		ifxEvalParamExprs(fdw_state, state);
+#endif
+
 	/*
 	 * We're in a rescan condition on our foreign table.
 	 */
@@ -3434,6 +6842,42 @@ ifxGetOptions(Oid foreigntableOid, IfxConnectionInfo *coninfo)
 			 */
 			coninfo->enable_blobs = 1;
 		}
+
+		if (strcmp(def->defname, "enable_key_tables") == 0)
+		{
+			/* the value isn't checked, same as enable_blobs */
+			coninfo->enable_key_tables = 1;
+		}
+
+		/*
+		 * batch_size can be specified for the server and the
+		 * foreign table. Table options are examined first, so
+		 * they take precedence.
+		 */
+		if ((strcmp(def->defname, "batch_size") == 0)
+			&& (coninfo->batch_size == 0))
+		{
+			coninfo->batch_size = ifxGetBatchSizeOption(def);
+		}
+
+		/*
+		 * Functions declared shippable to Informix. Both the
+		 * server and foreign table can specify a list, so merge them.
+		 */
+		if (strcmp(def->defname, "pushdown_functions") == 0)
+		{
+			if (coninfo->pushdown_functions == NULL)
+				coninfo->pushdown_functions = pstrdup(defGetString(def));
+			else
+			{
+				StringInfoData buf;
+
+				initStringInfo(&buf);
+				appendStringInfo(&buf, "%s,%s", coninfo->pushdown_functions,
+								 defGetString(def));
+				coninfo->pushdown_functions = buf.data;
+			}
+		}
 	}
 
 	if ((coninfo->query == NULL)
@@ -3519,6 +6963,124 @@ static char *ifxGenCursorName(IfxConnectionInfo *coninfo, int curid)
 	return cursor_name;
 }
 
+/*
+ * Clauses of a query which aren't allowed within a derived
+ * table or change its result set when it is wrapped into one.
+ */
+static const char *ifx_derived_table_keywords[] =
+{
+	"ORDER", "FIRST", "SKIP", "LIMIT", "INTO", NULL
+};
+
+/*
+ * Returns true in case the specified query contains any of the
+ * keywords in ifx_derived_table_keywords. String literals, delimited
+ * identifiers and comments are skipped. Since the query isn't parsed,
+ * a keyword within a subquery or a column named like a keyword
+ * counts as well.
+ */
+static bool ifxQueryHasDerivedTableKeyword(char *query)
+{
+	char *ptr = query;
+
+	while (*ptr != '\0')
+	{
+		if ((*ptr == '\'') || (*ptr == '"'))
+		{
+			char quote = *ptr++;
+
+			while ((*ptr != '\0') && (*ptr != quote))
+				ptr++;
+		}
+		else if ((*ptr == '-') && (*(ptr + 1) == '-'))
+		{
+			while ((*ptr != '\0') && (*ptr != '\n'))
+				ptr++;
+		}
+		else if (*ptr == '{')
+		{
+			while ((*ptr != '\0') && (*ptr != '}'))
+				ptr++;
+		}
+		else if ((*ptr == '/') && (*(ptr + 1) == '*'))
+		{
+			ptr += 2;
+			while ((*ptr != '\0') && !((*ptr == '*') && (*(ptr + 1) == '/')))
+				ptr++;
+			if (*ptr != '\0')
+				ptr++;
+		}
+		else if (isalpha((unsigned char) *ptr) || (*ptr == '_'))
+		{
+			char *start = ptr;
+			int   i;
+
+			while (isalnum((unsigned char) *ptr) || (*ptr == '_'))
+				ptr++;
+
+			for (i = 0; ifx_derived_table_keywords[i] != NULL; i++)
+			{
+				if ((strlen(ifx_derived_table_keywords[i]) == (size_t) (ptr - start))
+					&& (pg_strncasecmp(start, ifx_derived_table_keywords[i],
+									   ptr - start) == 0))
+					return true;
+			}
+
+			continue;
+		}
+
+		if (*ptr != '\0')
+			ptr++;
+	}
+
+	return false;
+}
+
+/*
+ * Returns the version of the Informix server of the specified
+ * connection, e.g. 1150 for 11.50, or -1 in case it's unknown.
+ *
+ * The server version is retrieved once per cached connection, the
+ * connection of the foreign table is made current for this.
+ */
+static int ifxGetCachedServerVersion(IfxConnectionInfo *coninfo)
+{
+	IfxCachedConnection *cached;
+	bool                 found;
+
+	cached = ifxConnCache_exists(coninfo->conname, &found);
+
+	if (!found)
+		return -1;
+
+	if (cached->server_version == 0)
+	{
+		ifxSetConnection(coninfo);
+		cached->server_version = ifxGetServerVersion();
+
+		elog(DEBUG1, "informix_fdw: server version of connection \"%s\": %d",
+			 coninfo->conname, cached->server_version);
+	}
+
+	return cached->server_version;
+}
+
+/*
+ * Returns true in case the query of a foreign table based on a
+ * query can be wrapped into a derived table, so that predicates,
+ * ORDER BY and FIRST can be pushed down. This requires Informix
+ * 11.50 or above, and the query must not have its own ORDER BY,
+ * FIRST, SKIP, LIMIT or INTO clause.
+ */
+static bool ifxQueryAllowsDerivedTable(IfxConnectionInfo *coninfo)
+{
+	if ((coninfo->query == NULL)
+		|| ifxQueryHasDerivedTableKeyword(coninfo->query))
+		return false;
+
+	return (ifxGetCachedServerVersion(coninfo) >= IFX_DERIVED_TABLE_MIN_VERSION);
+}
+
 /*
  * Prepare informix query object identifier
  */
@@ -3527,6 +7089,8 @@ static void ifxPrepareParamsForScan(IfxFdwExecutionState *state,
 {
 	StringInfoData *buf;
 	char           *rowid_str;
+	char           *collist;
+	bool            has_predicate;
 
 	buf = makeStringInfo();
 	initStringInfo(buf);
@@ -3539,6 +7103,19 @@ static void ifxPrepareParamsForScan(IfxFdwExecutionState *state,
 	else
 		rowid_str = "";
 
+	has_predicate = ((state->stmt_info.predicate != NULL)
+					 && (strlen(state->stmt_info.predicate) > 0)
+					 && coninfo->predicate_pushdown);
+
+	/*
+	 * Select all columns, unless some of them are mapped to
+	 * differently named remote columns via the column_name option
+	 * or only some of them are requested. In this case we must
+	 * name the remote columns explicitly.
+	 */
+	collist = ifxGetRemoteColumnList(state->foreignTableOid,
+									 state->projected_attrs);
+
 	/*
 	 * Record the given query and pass it over
 	 * to the state structure.
@@ -3554,18 +7131,39 @@ static void ifxPrepareParamsForScan(IfxFdwExecutionState *state,
 		 */
 		state->use_rowid = 0;
 
-		if ((state->stmt_info.predicate != NULL)
-			&& (strlen(state->stmt_info.predicate) > 0)
-			&& coninfo->predicate_pushdown)
+		/*
+		 * Pass the query unchanged if there's nothing to push down
+		 * or it can't be wrapped into a derived table. Predicates,
+		 * ORDER BY and FIRST aren't pushed down in the latter case,
+		 * see ifxGetForeignRelSize().
+		 */
+		if ((!has_predicate
+			 && (collist == NULL)
+			 && (state->sort_clause == NULL)
+			 && (state->limit_count <= 0))
+			|| !ifxQueryAllowsDerivedTable(coninfo))
 		{
-			appendStringInfo(buf, "%s WHERE %s",
-							 coninfo->query,
-							 state->stmt_info.predicate);
+			appendStringInfoString(buf, coninfo->query);
 		}
 		else
 		{
-			appendStringInfo(buf, "%s",
+			/*
+			 * Wrap the query into a derived table, so that predicates,
+			 * ORDER BY and FIRST apply to its result set regardless of
+			 * any WHERE, GROUP BY or UNION clauses of its own.
+			 */
+			appendStringInfoString(buf, "SELECT ");
+
+			if (state->limit_count > 0)
+				appendStringInfo(buf, "FIRST %d ", state->limit_count);
+
+			appendStringInfo(buf, "%s FROM (%s) q",
+							 (collist != NULL) ? collist : "*",
 							 coninfo->query);
+
+			if (has_predicate)
+				appendStringInfo(buf, " WHERE %s",
+								 state->stmt_info.predicate);
 		}
 	}
 	else
@@ -3586,21 +7184,36 @@ static void ifxPrepareParamsForScan(IfxFdwExecutionState *state,
 		 * ROWID (for example, if fragmented tables are used on the Informix
 		 * server).
 		 */
-		if ((state->stmt_info.predicate != NULL)
-			&& (strlen(state->stmt_info.predicate) > 0)
-			&& coninfo->predicate_pushdown)
+		appendStringInfoString(buf, "SELECT ");
+
+		/*
+		 * Restrict the number of rows returned by the
+		 * Informix server, if a LIMIT was pushed down.
+		 */
+		if (state->limit_count > 0)
+			appendStringInfo(buf, "FIRST %d ", state->limit_count);
+
+		appendStringInfo(buf, "%s%s FROM %s",
+						 (collist != NULL) ? collist : "*",
+						 rowid_str,
+						 coninfo->tablename);
+
+		if (has_predicate)
 		{
-			appendStringInfo(buf, "SELECT *%s FROM %s WHERE %s",
-							 rowid_str,
-							 coninfo->tablename,
+			appendStringInfo(buf, " WHERE %s",
 							 state->stmt_info.predicate);
 		}
-		else
-		{
-			appendStringInfo(buf, "SELECT *%s FROM %s",
-							 rowid_str,
-							 coninfo->tablename);
-		}
+	}
+
+	/*
+	 * Append the ORDER BY clause, if the planner has choosen
+	 * a path with sorted output. Note that this never happens for
+	 * an updatable cursor.
+	 */
+	if (state->sort_clause != NULL)
+	{
+		Assert(state->stmt_info.cursorUsage != IFX_UPDATE_CURSOR);
+		appendStringInfo(buf, " ORDER BY %s", state->sort_clause);
 	}
 
 	/*
@@ -3636,11 +7249,25 @@ ifxBeginForeignScan(ForeignScanState *node, int eflags)
 	Oid                   foreignTableOid;
 	bool                  conn_cached;
 	List                 *plan_values;
+#if PG_VERSION_NUM >= 90200
+	int                   nparams;
+#endif
 
 	elog(DEBUG3, "informix_fdw: begin scan");
 
 	plan_values = PG_SCANSTATE_PRIVATE_P(node);
-	foreignTableOid = RelationGetRelid(node->ss.ss_currentRelation);
+
+	/*
+	 * A foreign scan evaluating a pushed down join or aggregation
+	 * doesn't have a scan relation. The (outer) foreign table was
+	 * recorded by the planner in this case.
+	 */
+	if (node->ss.ss_currentRelation != NULL)
+		foreignTableOid = RelationGetRelid(node->ss.ss_currentRelation);
+	else
+		foreignTableOid = (Oid) ifxGetSerializedInt32Field(plan_values,
+														   SERIALIZED_FOREIGN_TABLE_OID);
+
 	Assert((foreignTableOid != InvalidOid));
 	coninfo = ifxMakeConnectionInfo(foreignTableOid);
 
@@ -3697,6 +7324,38 @@ ifxBeginForeignScan(ForeignScanState *node, int eflags)
 		ifxDeserializeFdwData(festate, plan_values);
 	}
 
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * Key tables referenced by the remote query must exist before
+	 * it is prepared, they are created here the first time. A plain
+	 * EXPLAIN neither creates them nor prepares the query. Their
+	 * arrays are passed after the placeholder values in fdw_exprs,
+	 * see ifxGetForeignPlan().
+	 */
+	nparams = list_length(((ForeignScan *) node->ss.ps.plan)->fdw_exprs)
+		- list_length(festate->key_tables);
+
+	if (festate->key_tables != NIL)
+	{
+		List     *key_exprs;
+		ListCell *cell_table;
+		ListCell *cell_expr;
+
+		key_exprs = list_copy_tail(((ForeignScan *) node->ss.ps.plan)->fdw_exprs,
+								   nparams);
+
+		if (!(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+		{
+			forboth(cell_table, festate->key_tables, cell_expr, key_exprs)
+				ifxCreateKeyTable(&festate->stmt_info, (char *) lfirst(cell_table),
+								  get_element_type(exprType((Node *) lfirst(cell_expr))));
+		}
+
+		festate->key_set_exprs = IFX_EXEC_INIT_EXPR_LIST(key_exprs,
+														 (PlanState *) node);
+	}
+#endif
+
 	/*
 	 * Recheck if everything is already prepared on the
 	 * informix server. If not, we are either in a rescan condition
@@ -3704,13 +7363,34 @@ ifxBeginForeignScan(ForeignScanState *node, int eflags)
 	 * previously done in the planning state. We do this to save
 	 * some cycles when just doing plain SELECTs.
 	 */
-	if (festate->stmt_info.call_stack == IFX_STACK_EMPTY)
+	if ((festate->stmt_info.call_stack == IFX_STACK_EMPTY)
+		&& !((eflags & EXEC_FLAG_EXPLAIN_ONLY)
+			 && (festate->key_tables != NIL)))
 		ifxPrepareCursorForScan(&festate->stmt_info, coninfo);
 
 	/*
-	 * Get the definition of the local foreign table attributes.
+	 * Get the definition of the local foreign table attributes. Without
+	 * a scan relation, the remote query returns the columns described by
+	 * the scan tuple descriptor.
 	 */
-	ifxPgColumnData(foreignTableOid, festate);
+#if PG_VERSION_NUM >= 90500
+	if (node->ss.ss_currentRelation == NULL)
+		ifxPgColumnDataFromTupleDesc(node->ss.ss_ScanTupleSlot->tts_tupleDescriptor,
+									 festate);
+	else
+#endif
+		ifxPgColumnData(foreignTableOid, festate);
+
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * Initialize the expressions bound to the placeholders
+	 * of the remote query, if any.
+	 */
+	festate->param_exprs = IFX_EXEC_INIT_EXPR_LIST(list_truncate(list_copy(((ForeignScan *) node->ss.ps.plan)->fdw_exprs),
+																 nparams),
+												   (PlanState *) node);
+	festate->param_count = list_length(festate->param_exprs);
+#endif
 
 	/* EXPLAIN without ANALYZE... */
 	if (eflags & EXEC_FLAG_EXPLAIN_ONLY)
@@ -3810,12 +7490,45 @@ ifxBeginForeignScan(ForeignScanState *node, int eflags)
 	 */
 	ifxSetupDataBufferAligned(&festate->stmt_info);
 
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * Ship the key sets to the Informix server. They don't depend
+	 * on an outer relation, so they're loaded only once per scan.
+	 */
+	if (festate->key_tables != NIL)
+		ifxLoadKeyTables(festate, node);
+#endif
+
+#if PG_VERSION_NUM >= 90300
+	/*
+	 * Placeholders bound to values of an outer relation (see
+	 * ifxAddForeignParamPaths()) don't get their values before the
+	 * first rescan, so defer opening the cursor to ifxFetchTuple().
+	 */
+	if ((festate->param_exprs != NIL)
+		&& ifxContainsExecParam((Node *) ((ForeignScan *) node->ss.ps.plan)->fdw_exprs,
+								NULL))
+	{
+		festate->rescan = true;
+		return;
+	}
+#endif
+
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * Evaluate the values bound to the placeholders of
+	 * the remote query.
+	 */
+	if (festate->param_exprs != NIL)
+		ifxEvalParamExprs(festate, node);
+#endif
+
 	/*
 	 * Open the cursor.
 	 */
 	elog(DEBUG1, "open cursor \"%s\"",
 		 festate->stmt_info.cursor_name);
-	ifxOpenCursorForPrepared(&festate->stmt_info);
+	ifxOpenScanCursor(festate);
 	ifxCatchExceptions(&festate->stmt_info, IFX_STACK_OPEN);
 
 }
@@ -4066,6 +7779,15 @@ static void ifxEndForeignScan(ForeignScanState *node)
 	 */
 	ifxRewindCallstack(&state->stmt_info);
 
+#if PG_VERSION_NUM >= 90200
+	/*
+	 * The key tables are named after the statement refid of
+	 * this scan, nobody else will use them.
+	 */
+	if (state->key_tables != NIL)
+		ifxDropScanKeyTables(state);
+#endif
+
 	/*
 	 * Save the callstack into cached plan structure. This
 	 * is necessary to teach ifxBeginForeignScan() to do the
@@ -4094,7 +7816,7 @@ static TupleTableSlot *ifxIterateForeignScan(ForeignScanState *node)
 	 * Make the informix connection belonging to this
 	 * iteration current.
 	 */
-	foreignTableOid = RelationGetRelid(node->ss.ss_currentRelation);
+	foreignTableOid = state->foreignTableOid;
 	coninfo= ifxMakeConnectionInfo(foreignTableOid);
 
 	/*
@@ -4231,16 +7953,33 @@ static IfxConnectionInfo *ifxMakeConnectionInfo(Oid foreignTableOid)
  *
  * NOTE: excl_restrictInfo is a List, holding all rejected RestrictInfo
  * structs found not able to be pushed down.
+ *
+ * coninfo supplies the user functions declared shippable by the
+ * pushdown_functions option.
+ *
+ * Expressions evaluated during executor startup (Params and stable
+ * expressions) are deparsed into placeholders and returned in params,
+ * in case the caller passes a valid pointer. Otherwise predicates
+ * referencing them are evaluated locally.
+ *
+ * Likewise, arrays of col = ANY(...) predicates too large for an IN
+ * list or only known during execution are shipped via key tables
+ * and returned in key_sets (list of IfxKeySet), if requested.
+ * The key tables are named after refid, the statement refid of
+ * the scan.
  */
 static char * ifxFilterQuals(PlannerInfo *planInfo,
 							 RelOptInfo *baserel,
 							 List **excl_restrictInfo,
-							 Oid foreignTableOid)
+							 Oid foreignTableOid,
+							 IfxConnectionInfo *coninfo,
+							 List **params,
+							 List **key_sets,
+							 int refid)
 {
 	IfxPushdownOprContext pushdownCxt;
 	ListCell             *cell;
 	StringInfoData       *buf;
-	char                 *oprStr;
 	int i;
 
 	Assert(foreignTableOid != InvalidOid);
@@ -4251,6 +7990,14 @@ static char * ifxFilterQuals(PlannerInfo *planInfo,
 	pushdownCxt.count         = 0;
 	pushdownCxt.count_removed = 0;
 	pushdownCxt.has_or_expr   = false;
+	pushdownCxt.shippable_funcs = ifxParseShippableFunctions(coninfo->pushdown_functions);
+	pushdownCxt.allow_params    = (params != NULL);
+	pushdownCxt.params          = NIL;
+	pushdownCxt.allow_key_sets  = (key_sets != NULL);
+	pushdownCxt.key_sets        = NIL;
+	pushdownCxt.key_set_base    = 0;
+	pushdownCxt.key_set_refid   = refid;
+	pushdownCxt.toplevel        = true;
 
 	/* Be paranoid, excluded RestrictInfo list initialized to be empty */
 	*excl_restrictInfo = NIL;
@@ -4262,94 +8009,68 @@ static char * ifxFilterQuals(PlannerInfo *planInfo,
 	 * Loop through the operator nodes and try to
 	 * extract the pushdown expressions as a text datum
 	 * to the pushdown context structure.
+	 *
+	 * Pushdown is decided per RestrictInfo: a clause is pushed
+	 * down only if ifx_predicate_tree_walker() was able to
+	 * translate it completely into exactly one predicate, otherwise
+	 * its predicates are discarded and the clause is left to
+	 * the executor. Since all restriction clauses are AND'ed, this
+	 * is safe even for clauses containing OR expressions.
 	 */
 	foreach(cell, baserel->baserestrictinfo)
 	{
 		RestrictInfo *info;
 		int found;
+		int removed;
+		int nparams;
+		int nkeysets;
 
 		info = (RestrictInfo *) lfirst(cell);
 
-		found = pushdownCxt.count;
+		found   = pushdownCxt.count;
+		removed = pushdownCxt.count_removed;
+		nparams = list_length(pushdownCxt.params);
+		nkeysets = list_length(pushdownCxt.key_sets);
 		ifx_predicate_tree_walker((Node *)info->clause, &pushdownCxt);
 
-		if (found == pushdownCxt.count)
+		if ((pushdownCxt.count != found + 1)
+			|| (pushdownCxt.count_removed != removed))
 		{
-			elog(DEBUG2, "RestrictInfo doesn't hold anything interesting, skipping");
+			elog(DEBUG2, "RestrictInfo not suitable for pushdown, skipping");
 			*excl_restrictInfo = lappend(*excl_restrictInfo, info);
-		}
-
-		/*
-		 * Each list element from baserestrictinfo is AND'ed together.
-		 * Record a corresponding IfxPushdownOprInfo structure in
-		 * the context, so that it get decoded properly below.
-		 */
-		if (lnext(cell) != NULL)
-		{
-			IfxPushdownOprInfo *pushAndInfo;
 
-			pushAndInfo              = palloc(sizeof(IfxPushdownOprInfo));
-			pushAndInfo->type        = IFX_OPR_AND;
-			pushAndInfo->expr_string = cstring_to_text("AND");
-
-			pushdownCxt.predicates = lappend(pushdownCxt.predicates, pushAndInfo);
-			pushdownCxt.count++;
+			/*
+			 * Discard any partial predicates of this clause.
+			 */
+			pushdownCxt.predicates = list_truncate(pushdownCxt.predicates, found);
+			pushdownCxt.count      = found;
+			pushdownCxt.params     = list_truncate(pushdownCxt.params, nparams);
+			pushdownCxt.key_sets   = list_truncate(pushdownCxt.key_sets, nkeysets);
 		}
 	}
 
-	/*
-	 * Since restriction clauses are always AND together,
-	 * assume a AND_EXPR per default.
-	 */
-	oprStr = "AND";
+	if (params != NULL)
+		*params = pushdownCxt.params;
 
-	/*
-	 * Check wether ifx_predicate_tree_walker() encountered a OR'ed
-	 * expression and removed some clauses...we can't rely on the returned
-	 * predicate string, so assume we can't push down any. This won't be safe,
-	 * since we might push down a partial OR expression which would lead
-	 * to wrong results. We might try to be a little smarter here, but leave
-	 * that to future improvements...
-	 */
-	if (pushdownCxt.has_or_expr
-		&& ( pushdownCxt.count_removed > 0))
-		return "";
+	if (key_sets != NULL)
+		*key_sets = pushdownCxt.key_sets;
 
 	/*
 	 * Filter step done, if any predicates to be able to be
 	 * pushed down are found, we have a list of IfxPushDownOprInfo
-	 * structure in the IfxPushdownOprContext structure. Loop
-	 * through them and attach all supported filter quals into
-	 * our result buffer.
+	 * structure in the IfxPushdownOprContext structure, one for
+	 * each pushed down RestrictInfo. AND them together into our
+	 * result buffer.
 	 */
 	for (i = 0; i < pushdownCxt.count; i++)
 	{
 		IfxPushdownOprInfo *info;
 
 		info = (IfxPushdownOprInfo *) list_nth(pushdownCxt.predicates, i);
-
-		/* ignore filtered expressions */
-		if (info->type == IFX_OPR_NOT_SUPPORTED)
-		{
-			continue;
-		}
-
-		switch (info->type)
-		{
-			case IFX_OPR_OR:
-			case IFX_OPR_AND:
-			case IFX_OPR_NOT:
-				/* save current boolean opr context */
-				oprStr = text_to_cstring(info->expr_string);
-				break;
-			case IFX_IS_NULL:
-			case IFX_IS_NOT_NULL:
-				/* fall through, no special action necessary */
-			default:
-				appendStringInfo(buf, " %s %s",
-								 (i > 1) ? oprStr : "",
-								 text_to_cstring(info->expr_string));
-		}
+
+		appendStringInfo(buf, "%s%s",
+						 (i > 0) ? " AND " : "",
+						 text_to_cstring(info->expr_string));
 	}
 
 	/* empty string in case no pushdown predicates are found */
@@ -4454,9 +8175,19 @@ ifxExplainForeignScan(ForeignScanState *node, ExplainState *es)
 	/* Give some possibly useful info about startup costs */
 	if (es->costs)
 	{
+#if PG_VERSION_NUM >= 110000
+		ExplainPropertyFloat("Informix costs", NULL, planData.costs, 2, es);
+#else
 		ExplainPropertyFloat("Informix costs", planData.costs, 2, es);
-		ExplainPropertyText("Informix query", festate->stmt_info.query, es);
+#endif
 	}
+
+	/*
+	 * The remote query is also shown with EXPLAIN (VERBOSE, COSTS OFF),
+	 * which is what the regression tests rely on to get stable output.
+	 */
+	if (es->costs || es->verbose)
+		ExplainPropertyText("Informix query", festate->stmt_info.query, es);
 }
 
 
@@ -4484,6 +8215,15 @@ static void ifxConnInfoSetDefaults(IfxConnectionInfo *coninfo)
 	/* disable enable_blobs per default */
 	coninfo->enable_blobs = 0;
 
+	/* no key tables per default */
+	coninfo->enable_key_tables = 0;
+
+	/* modify actions don't send rows in batches per default */
+	coninfo->batch_size = 0;
+
+	/* no user defined functions shippable per default */
+	coninfo->pushdown_functions = NULL;
+
 	/*
 	 * Use rowid for DML per default.
 	 */
@@ -4820,6 +8560,71 @@ ifxGetConnections(PG_FUNCTION_ARGS)
 	}
 }
 
+/*
+ * ifxDropKeyTables()
+ *
+ * Drops all key tables created on the specified cached connection,
+ * which must be current. Errors are ignored, a key table might
+ * already be gone.
+ */
+static void ifxDropKeyTables(IfxCachedConnection *cached)
+{
+	ListCell *cell;
+
+	foreach(cell, cached->key_tables)
+	{
+		StringInfoData buf;
+
+		initStringInfo(&buf);
+		appendStringInfo(&buf, "DROP TABLE %s", (char *) lfirst(cell));
+
+		elog(DEBUG1, "informix_fdw: drop key table \"%s\"",
+			 (char *) lfirst(cell));
+
+		ifxExecuteImmediate(buf.data);
+	}
+
+	ifxConnCache_resetKeyTables(cached);
+}
+
+/*
+ * ifxDropScanKeyTables()
+ *
+ * Drops the key tables created by the specified foreign scan,
+ * called at the end of the scan. Key tables never created, e.g.
+ * by a plain EXPLAIN, are skipped.
+ */
+static void ifxDropScanKeyTables(IfxFdwExecutionState *state)
+{
+	IfxCachedConnection *cached;
+	ListCell            *cell;
+	bool                 found;
+
+	cached = ifxConnCache_exists(state->stmt_info.conname, &found);
+
+	if (!found)
+		return;
+
+	foreach(cell, state->key_tables)
+	{
+		char          *tablename = (char *) lfirst(cell);
+		StringInfoData buf;
+
+		if (!ifxConnCache_hasKeyTable(cached, tablename))
+			continue;
+
+		initStringInfo(&buf);
+		appendStringInfo(&buf, "DROP TABLE %s", tablename);
+
+		elog(DEBUG1, "informix_fdw: drop key table \"%s\"", tablename);
+
+		ifxExecuteImmediate(buf.data);
+		ifxCatchExceptions(&state->stmt_info, 0);
+
+		ifxConnCache_removeKeyTable(cached, tablename);
+	}
+}
+
 /*
  * ifxXactFinalize()
  *
@@ -4864,6 +8669,12 @@ static int ifxXactFinalize(IfxCachedConnection *cached,
 
 	if (action == IFX_TX_COMMIT)
 	{
+		/*
+		 * Drop the key tables created within this transaction,
+		 * they're created again by the next scan requiring them.
+		 */
+		ifxDropKeyTables(cached);
+
 		/*
 		 * Commit the transaction
 		 */
@@ -4881,6 +8692,12 @@ static int ifxXactFinalize(IfxCachedConnection *cached,
 	}
 	else if (action == IFX_TX_ROLLBACK)
 	{
+		/*
+		 * Key tables created within this transaction are
+		 * gone after the rollback, so forget about them.
+		 */
+		ifxConnCache_resetKeyTables(cached);
+
 		/* Rollback current transaction */
 		if (ifxRollbackTransaction(&cached->con, 0) < 0)
 		{
@@ -5068,6 +8885,13 @@ static void ifx_fdw_subxact_callback(SubXactEvent event,
 			/* This is subxact rollback action */
 			elog(DEBUG3, "informix_fdw: rollback xact level %d", curlevel);
 
+			/*
+			 * We don't track which savepoint a key table was created
+			 * in, so forget about all of them. Recreating an existing
+			 * key table is tolerated later.
+			 */
+			ifxConnCache_resetKeyTables(cached);
+
 			if (ifxRollbackTransaction(&cached->con, curlevel) < 0)
 			{
 				ereport(WARNING,
@@ -5081,8 +8905,526 @@ static void ifx_fdw_subxact_callback(SubXactEvent event,
 
 }
 
+#if PG_VERSION_NUM >= 90200
+
+/*
+ * ProcessUtility hook, records the column lists passed
+ * to ANALYZE. The FDW ANALYZE callbacks don't get them
+ * from PostgreSQL, see ifxGetAnalyzeColumns().
+ */
+static void ifxProcessUtility(IFX_PROCESS_UTILITY_ARGS)
+{
+	Node *stmt = IFX_PROCESS_UTILITY_PARSETREE;
+	List *saved_columns = ifx_analyze_columns;
+
+	if (IsA(stmt, VacuumStmt)
+		&& (((VacuumStmt *) stmt)->options & VACOPT_ANALYZE))
+	{
+		VacuumStmt *vacstmt = (VacuumStmt *) stmt;
+		List       *columns = NIL;
+#if PG_VERSION_NUM >= 110000
+		ListCell   *cell;
+
+		foreach(cell, vacstmt->rels)
+		{
+			VacuumRelation *vacrel = (VacuumRelation *) lfirst(cell);
+			RangeVar       *relation = vacrel->relation;
+			List           *va_cols = vacrel->va_cols;
+#else
+		{
+			RangeVar       *relation = vacstmt->relation;
+			List           *va_cols = vacstmt->va_cols;
+#endif
+
+			if ((relation != NULL) && (va_cols != NIL))
+			{
+				IfxAnalyzeColumns *entry;
+
+				entry = (IfxAnalyzeColumns *) palloc(sizeof(IfxAnalyzeColumns));
+				entry->relid   = RangeVarGetRelid(relation, NoLock, true);
+				entry->va_cols = va_cols;
+				columns = lappend(columns, entry);
+			}
+		}
+
+		ifx_analyze_columns = columns;
+	}
+
+	PG_TRY();
+	{
+		if (prev_ProcessUtility)
+			prev_ProcessUtility(IFX_PROCESS_UTILITY_CALL);
+		else
+			standard_ProcessUtility(IFX_PROCESS_UTILITY_CALL);
+	}
+	PG_CATCH();
+	{
+		ifx_analyze_columns = saved_columns;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+
+	ifx_analyze_columns = saved_columns;
+}
+
+/*
+ * Returns the attribute numbers of the columns passed to the
+ * currently executed ANALYZE command for the specified relation,
+ * or NULL in case all columns are analyzed.
+ *
+ * NOTE: This relies on ifxProcessUtility(), which is only
+ *       installed once the informix_fdw library is loaded.
+ */
+static Bitmapset *ifxGetAnalyzeColumns(Oid relid)
+{
+	ListCell *cell;
+
+	foreach(cell, ifx_analyze_columns)
+	{
+		IfxAnalyzeColumns *entry = (IfxAnalyzeColumns *) lfirst(cell);
+		Bitmapset         *attrs = NULL;
+		ListCell          *colcell;
+
+		if (entry->relid != relid)
+			continue;
+
+		foreach(colcell, entry->va_cols)
+		{
+			AttrNumber attnum = get_attnum(relid, strVal(lfirst(colcell)));
+
+			if (attnum != InvalidAttrNumber)
+				attrs = bms_add_member(attrs, attnum);
+		}
+
+		return attrs;
+	}
+
+	return NULL;
+}
+
+#endif
+
+#if PG_VERSION_NUM >= 90300
+
+/*
+ * Autoanalyze background worker
+ *
+ * Foreign tables are never analyzed by autovacuum. The worker
+ * periodically compares the number of rows recorded in systables
+ * on the Informix server with reltuples of each foreign table
+ * defined with the table option. If it differs by more than
+ * informix_fdw.autoanalyze_scale_factor, reltuples and relpages are
+ * updated immediately and the foreign table is analyzed.
+ *
+ * At most informix_fdw.autoanalyze_max_per_server foreign tables of
+ * the same foreign server are analyzed per round, all others are
+ * remembered and analyzed during the next rounds.
+ */
+
+/*
+ * Foreign table examined by ifxAutoAnalyzeRound().
+ */
+typedef struct IfxAutoAnalyzeTable
+{
+	Oid    relid;
+	Oid    serverid;
+	double reltuples;
+} IfxAutoAnalyzeTable;
+
+#if PG_VERSION_NUM >= 90500
+#define IFX_MY_LATCH MyLatch
+#else
+#define IFX_MY_LATCH (&MyProc->procLatch)
+#endif
+
+#if PG_VERSION_NUM >= 100000
+#define IFX_WAIT_LATCH(latch, events, timeout) \
+	WaitLatch((latch), (events), (timeout), PG_WAIT_EXTENSION)
+#else
+#define IFX_WAIT_LATCH(latch, events, timeout) \
+	WaitLatch((latch), (events), (timeout))
+#endif
+
+#if PG_VERSION_NUM >= 110000
+#define IFX_BGWORKER_CONNECT(dbname) \
+	BackgroundWorkerInitializeConnection((dbname), NULL, 0)
+#else
+#define IFX_BGWORKER_CONNECT(dbname) \
+	BackgroundWorkerInitializeConnection((dbname), NULL)
+#endif
+
+static void ifxAutoAnalyzeSigterm(SIGNAL_ARGS)
+{
+	int save_errno = errno;
+
+	ifx_autoanalyze_got_sigterm = true;
+	SetLatch(IFX_MY_LATCH);
+
+	errno = save_errno;
+}
+
+static void ifxAutoAnalyzeSighup(SIGNAL_ARGS)
+{
+	int save_errno = errno;
+
+	ifx_autoanalyze_got_sighup = true;
+	SetLatch(IFX_MY_LATCH);
+
+	errno = save_errno;
+}
+
+/*
+ * Updates reltuples and relpages of the specified foreign
+ * table in place, the same way ANALYZE does.
+ */
+static void ifxUpdateRelStats(Oid relid, double reltuples,
+							  BlockNumber relpages)
+{
+	Relation      rd;
+	HeapTuple     ctup;
+	Form_pg_class pgcform;
+
+	rd = heap_open(RelationRelationId, RowExclusiveLock);
+
+	ctup = SearchSysCacheCopy1(RELOID, ObjectIdGetDatum(relid));
+	if (!HeapTupleIsValid(ctup))
+		elog(ERROR, "pg_class entry for relid %u vanished during autoanalyze",
+			 relid);
+
+	pgcform = (Form_pg_class) GETSTRUCT(ctup);
+	pgcform->reltuples = (float4) reltuples;
+	pgcform->relpages  = (int32) relpages;
+
+	heap_inplace_update(rd, ctup);
+	heap_close(rd, RowExclusiveLock);
+}
+
+/*
+ * Checks the remote statistics of the specified foreign table and
+ * analyzes it, if they have changed significantly or a previous
+ * round had to defer it. ANALYZE is deferred if may_analyze is false.
+ *
+ * Returns true if the foreign table was analyzed.
+ */
+static bool ifxAutoAnalyzeTable(IfxAutoAnalyzeTable *table, bool may_analyze)
+{
+	IfxConnectionInfo    *coninfo;
+	IfxCachedConnection  *cached_handle;
+	IfxFdwExecutionState *state;
+	IfxPlanData           planData;
+	StringInfoData        buf;
+	MemoryContext         oldcontext;
+	bool                  pending;
+	bool                  changed;
+
+	if ((cached_handle = ifxSetupConnection(&coninfo, table->relid,
+											IFX_PLAN_SCAN, false)) == NULL)
+		return false;
+
+	/* no systables entry for a foreign table based on a query */
+	if (coninfo->query != NULL)
+		return false;
+
+	state = makeIfxFdwExecutionState(cached_handle->con.usage);
+
+	ifxGetSystableStats(coninfo->tablename, &planData);
+
+	if (ifxSetException(&(state->stmt_info)) != IFX_SUCCESS)
+	{
+		elog(DEBUG1, "informix_fdw: no remote stats data found for table \"%s\"",
+			 get_rel_name(table->relid));
+		return false;
+	}
+
+	pending = list_member_oid(ifx_autoanalyze_pending, table->relid);
+
+	if (table->reltuples <= 0)
+		changed = (planData.nrows > 0);
+	else
+		changed = (fabs(planData.nrows - table->reltuples)
+				   > ifx_autoanalyze_scale_factor * table->reltuples);
+
+	if (!changed && !pending)
+		return false;
+
+	elog(DEBUG1, "informix_fdw: remote table of \"%s\" changed from %.0f to %.0f rows",
+		 get_rel_name(table->relid), table->reltuples, planData.nrows);
+
+	if (changed)
+		ifxUpdateRelStats(table->relid, planData.nrows,
+						  ifxSystablePages(&planData));
+
+	/* remember the foreign table for the next round */
+	if (!may_analyze)
+	{
+		oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+		ifx_autoanalyze_pending = list_append_unique_oid(ifx_autoanalyze_pending,
+														 table->relid);
+		MemoryContextSwitchTo(oldcontext);
+		return false;
+	}
+
+	initStringInfo(&buf);
+	appendStringInfo(&buf, "ANALYZE %s",
+					 quote_qualified_identifier(get_namespace_name(get_rel_namespace(table->relid)),
+												get_rel_name(table->relid)));
+
+	elog(LOG, "informix_fdw: autoanalyze of foreign table \"%s\"",
+		 get_rel_name(table->relid));
+
+	if (SPI_execute(buf.data, false, 0) < 0)
+		elog(ERROR, "informix_fdw: could not execute \"%s\"", buf.data);
+
+	oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+	ifx_autoanalyze_pending = list_delete_oid(ifx_autoanalyze_pending,
+											  table->relid);
+	MemoryContextSwitchTo(oldcontext);
+
+	return true;
+}
+
+/*
+ * Examines all foreign tables of informix_fdw in the
+ * database the worker is connected to.
+ */
+static void ifxAutoAnalyzeRound(void)
+{
+	IfxAutoAnalyzeTable *tables;
+	int                 *analyzed;
+	int                  ntables;
+	int                  i;
+
+	SetCurrentStatementStartTimestamp();
+	StartTransactionCommand();
+	SPI_connect();
+	PushActiveSnapshot(GetTransactionSnapshot());
+
+	if (SPI_execute("SELECT ft.ftrelid, ft.ftserver, c.reltuples "
+					"FROM pg_catalog.pg_foreign_table ft "
+					"JOIN pg_catalog.pg_class c ON c.oid = ft.ftrelid "
+					"JOIN pg_catalog.pg_foreign_server s ON s.oid = ft.ftserver "
+					"JOIN pg_catalog.pg_foreign_data_wrapper w ON w.oid = s.srvfdw "
+					"JOIN pg_catalog.pg_proc p ON p.oid = w.fdwhandler "
+					"WHERE p.proname = 'ifx_fdw_handler' "
+					"ORDER BY ft.ftrelid",
+					true, 0) != SPI_OK_SELECT)
+		elog(ERROR, "informix_fdw: could not retrieve foreign tables");
+
+	/*
+	 * Copy the result, SPI_tuptable is replaced by the
+	 * ANALYZE commands executed later.
+	 */
+	ntables = (int) SPI_processed;
+	tables   = (IfxAutoAnalyzeTable *) palloc0(Max(ntables, 1) * sizeof(IfxAutoAnalyzeTable));
+	analyzed = (int *) palloc0(Max(ntables, 1) * sizeof(int));
+
+	for (i = 0; i < ntables; i++)
+	{
+		HeapTuple tuple   = SPI_tuptable->vals[i];
+		TupleDesc tupdesc = SPI_tuptable->tupdesc;
+		bool      isnull;
+
+		tables[i].relid     = DatumGetObjectId(SPI_getbinval(tuple, tupdesc, 1, &isnull));
+		tables[i].serverid  = DatumGetObjectId(SPI_getbinval(tuple, tupdesc, 2, &isnull));
+		tables[i].reltuples = DatumGetFloat4(SPI_getbinval(tuple, tupdesc, 3, &isnull));
+	}
+
+	for (i = 0; i < ntables; i++)
+	{
+		MemoryContext oldcontext = CurrentMemoryContext;
+		ResourceOwner oldowner   = CurrentResourceOwner;
+		int           nserver    = 0;
+		int           j;
+
+		/*
+		 * Number of foreign tables of the same server
+		 * analyzed during this round.
+		 */
+		for (j = 0; j < i; j++)
+		{
+			if (tables[j].serverid == tables[i].serverid)
+				nserver += analyzed[j];
+		}
+
+		/*
+		 * Examine each foreign table within its own subtransaction,
+		 * so that an unreachable Informix server or a broken foreign
+		 * table definition doesn't affect the others.
+		 */
+		BeginInternalSubTransaction(NULL);
+		MemoryContextSwitchTo(oldcontext);
+
+		PG_TRY();
+		{
+			analyzed[i] = ifxAutoAnalyzeTable(&tables[i],
+											  nserver < ifx_autoanalyze_max_per_server)
+				? 1 : 0;
+
+			ReleaseCurrentSubTransaction();
+			MemoryContextSwitchTo(oldcontext);
+			CurrentResourceOwner = oldowner;
+		}
+		PG_CATCH();
+		{
+			ErrorData *edata;
+
+			MemoryContextSwitchTo(oldcontext);
+			edata = CopyErrorData();
+			FlushErrorState();
+
+			RollbackAndReleaseCurrentSubTransaction();
+			MemoryContextSwitchTo(oldcontext);
+			CurrentResourceOwner = oldowner;
+#if PG_VERSION_NUM < 100000
+			SPI_restore_connection();
+#endif
+
+			ereport(LOG,
+					(errmsg("informix_fdw: autoanalyze of foreign table %u failed: %s",
+							tables[i].relid, edata->message)));
+			FreeErrorData(edata);
+		}
+		PG_END_TRY();
+	}
+
+	SPI_finish();
+	PopActiveSnapshot();
+	CommitTransactionCommand();
+}
+
+/*
+ * Main entry point of the autoanalyze background worker.
+ */
+void ifxAutoAnalyzeMain(Datum main_arg)
+{
+	pqsignal(SIGHUP, ifxAutoAnalyzeSighup);
+	pqsignal(SIGTERM, ifxAutoAnalyzeSigterm);
+
+	BackgroundWorkerUnblockSignals();
+
+	IFX_BGWORKER_CONNECT(ifx_autoanalyze_database);
+
+	elog(LOG, "informix_fdw: autoanalyze worker started for database \"%s\"",
+		 ifx_autoanalyze_database);
+
+	while (!ifx_autoanalyze_got_sigterm)
+	{
+		int rc;
+
+		rc = IFX_WAIT_LATCH(IFX_MY_LATCH,
+							WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+							ifx_autoanalyze_naptime * 1000L);
+		ResetLatch(IFX_MY_LATCH);
+
+		if (rc & WL_POSTMASTER_DEATH)
+			proc_exit(1);
+
+		if (ifx_autoanalyze_got_sighup)
+		{
+			ifx_autoanalyze_got_sighup = false;
+			ProcessConfigFile(PGC_SIGHUP);
+		}
+
+		if (ifx_autoanalyze_got_sigterm)
+			break;
+
+		if (rc & WL_TIMEOUT)
+			ifxAutoAnalyzeRound();
+	}
+
+	proc_exit(0);
+}
+
+/*
+ * Defines the GUCs of the autoanalyze worker and registers it,
+ * in case ifx_fdw is loaded via shared_preload_libraries and
+ * informix_fdw.autoanalyze_database is set.
+ */
+static void ifxAutoAnalyzeInit(void)
+{
+	BackgroundWorker worker;
+
+	DefineCustomStringVariable("informix_fdw.autoanalyze_database",
+							   "Database the autoanalyze worker connects to.",
+							   "The worker is disabled if not set.",
+							   &ifx_autoanalyze_database,
+							   NULL,
+							   PGC_POSTMASTER,
+							   0,
+							   NULL, NULL, NULL);
+
+	DefineCustomIntVariable("informix_fdw.autoanalyze_naptime",
+							"Time to sleep between autoanalyze rounds.",
+							NULL,
+							&ifx_autoanalyze_naptime,
+							600,
+							1,
+							INT_MAX / 1000,
+							PGC_SIGHUP,
+							GUC_UNIT_S,
+							NULL, NULL, NULL);
+
+	DefineCustomRealVariable("informix_fdw.autoanalyze_scale_factor",
+							 "Fraction of the number of rows of a remote table "
+							 "which has to change to analyze a foreign table.",
+							 NULL,
+							 &ifx_autoanalyze_scale_factor,
+							 0.1,
+							 0.0,
+							 100.0,
+							 PGC_SIGHUP,
+							 0,
+							 NULL, NULL, NULL);
+
+	DefineCustomIntVariable("informix_fdw.autoanalyze_max_per_server",
+							"Maximum number of foreign tables of a foreign server "
+							"analyzed per autoanalyze round.",
+							"0 only updates the number of rows and pages.",
+							&ifx_autoanalyze_max_per_server,
+							1,
+							0,
+							INT_MAX,
+							PGC_SIGHUP,
+							0,
+							NULL, NULL, NULL);
+
+	if (!process_shared_preload_libraries_in_progress
+		|| (ifx_autoanalyze_database == NULL)
+		|| (strlen(ifx_autoanalyze_database) == 0))
+		return;
+
+	memset(&worker, 0, sizeof(BackgroundWorker));
+	snprintf(worker.bgw_name, BGW_MAXLEN, "informix_fdw autoanalyze");
+#if PG_VERSION_NUM >= 110000
+	snprintf(worker.bgw_type, BGW_MAXLEN, "informix_fdw autoanalyze");
+#endif
+	worker.bgw_flags        = BGWORKER_SHMEM_ACCESS | BGWORKER_BACKEND_DATABASE_CONNECTION;
+	worker.bgw_start_time   = BgWorkerStart_RecoveryFinished;
+	worker.bgw_restart_time = ifx_autoanalyze_naptime;
+#if PG_VERSION_NUM >= 90400
+	snprintf(worker.bgw_library_name, BGW_MAXLEN, "ifx_fdw");
+	snprintf(worker.bgw_function_name, BGW_MAXLEN, "ifxAutoAnalyzeMain");
+#else
+	worker.bgw_main = ifxAutoAnalyzeMain;
+#endif
+	worker.bgw_main_arg = (Datum) 0;
+
+	RegisterBackgroundWorker(&worker);
+}
+
+#endif
+
 void _PG_init()
 {
 	RegisterXactCallback(ifx_fdw_xact_callback, NULL);
 	RegisterSubXactCallback(ifx_fdw_subxact_callback, NULL);
+
+#if PG_VERSION_NUM >= 90200
+	prev_ProcessUtility = ProcessUtility_hook;
+	ProcessUtility_hook = ifxProcessUtility;
+#endif
+
+#if PG_VERSION_NUM >= 90300
+	ifxAutoAnalyzeInit();
+#endif
 }
@@ -178,10 +178,104 @@ typedef struct IfxFdwExecutionState
 	 */
 	bool has_after_row_triggers;
 
+	/*
+	 * ORDER BY clause to be pushed down to the remote server. This
+	 * is derived from the pathkeys of the foreign path choosen by the
+	 * planner and is NULL in case no sorted output is requested.
+	 */
+	char *sort_clause;
+
+	/*
+	 * Number of rows requested from the remote server (SELECT FIRST n),
+	 * in case a LIMIT was pushed down. 0 means no restriction.
+	 */
+	int limit_count;
+
+	/*
+	 * OID of the foreign table scanned. Scans without a scan relation
+	 * (e.g. pushed down aggregates) rely on this.
+	 */
+	Oid foreignTableOid;
+
+	/*
+	 * Expressions bound to the placeholders of the remote query
+	 * (see ifxDeparseParamExpr()) and their values as character
+	 * strings, evaluated in ifxBeginForeignScan(). A NULL value
+	 * is bound as SQL NULL.
+	 */
+	List  *param_exprs;
+	int    param_count;
+	char **param_values;
+
+	/*
+	 * Names of the key tables referenced by the remote query
+	 * and the expressions evaluated into them, in the same
+	 * order (see ifxLoadKeyTables()).
+	 */
+	List  *key_tables;
+	List  *key_set_exprs;
+
+	/*
+	 * Attribute numbers of the columns retrieved from the remote
+	 * table, in case only some of them are required (e.g. by
+	 * ANALYZE with a column list). NULL retrieves all columns.
+	 */
+	Bitmapset *projected_attrs;
+
+	/*
+	 * Number of rows sent per batch by a modify action (batch_size
+	 * option, 0 disables batching), the number of rows pending in the
+	 * current batch and the number of rows already sent by completed
+	 * batches. The batch of an INSERT ends whenever the INSERT cursor
+	 * sends its buffered rows. Used to report the failing row of a batch.
+	 */
+	int    batch_size;
+	int    batch_rows;
+	long   batch_start;
+
+	/*
+	 * A batched UPDATE or DELETE binds the ROWIDs of its rows to the
+	 * placeholders following the new column values. Unused placeholders
+	 * repeat the first ROWID of the batch. All rows of an UPDATE batch
+	 * share the same new column values, saved here (indexed by
+	 * attribute number - 1).
+	 */
+	int    batch_first_rowid;
+	Datum *batch_values;
+	bool  *batch_nulls;
+
+	/*
+	 * Number of rows affected by a direct UPDATE or DELETE,
+	 * -1 as long as the statement wasn't executed yet (see
+	 * ifxIterateDirectModify()).
+	 */
+	long   affected_rows;
+
 } IfxFdwExecutionState;
 
 #if PG_VERSION_NUM >= 90200
 
+/*
+ * Column list of a foreign table passed to ANALYZE,
+ * see ifxProcessUtility().
+ */
+typedef struct IfxAnalyzeColumns
+{
+	Oid   relid;   /* OID of the analyzed relation */
+	List *va_cols; /* column names (list of String) */
+} IfxAnalyzeColumns;
+
+/*
+ * Index of a remote table mapped to the local columns of
+ * the foreign table, see ifxGetForeignIndexes().
+ */
+typedef struct IfxIndexDef
+{
+	bool        unique;   /* all index columns are mapped and unique */
+	int         ncolumns; /* number of leading index columns mapped */
+	AttrNumber *attnums;  /* local attribute numbers of index columns */
+} IfxIndexDef;
+
 /*
  * PostgreSQL > 9.2 uses a much smarter planning infrastructure which
  * requires us to submit state structures to different callbacks. Unify
@@ -196,10 +290,72 @@ typedef struct IfxFdwPlanState
 	 * Excluded RestrictInfo after pushdown analysis.
 	 */
 	List *excl_restrictInfo;
+
+	/*
+	 * OID of the foreign table this plan state belongs to.
+	 */
+	Oid foreignTableOid;
+
+	/*
+	 * Target list describing the tuples returned by the remote
+	 * query, in case it doesn't return rows of the foreign table
+	 * (e.g. pushed down aggregates). NIL otherwise.
+	 */
+	List *scan_tlist;
+
+	/*
+	 * Execution states of the foreign tables evaluated by a pushed
+	 * down join or aggregation. Their statements prepared during
+	 * planning are released once the remote query is choosen.
+	 */
+	List *input_states;
+
+	/*
+	 * Expressions evaluated during executor startup, bound to
+	 * the placeholders of the remote query in the order they
+	 * appear. Passed to the executor via fdw_exprs.
+	 */
+	List *param_exprs;
+
+	/*
+	 * Key sets (list of IfxKeySet) referenced by the pushed
+	 * down predicate. Their arrays are loaded into key tables
+	 * on the remote server before the scan starts.
+	 */
+	List *key_sets;
+
+	/*
+	 * Indexes of the remote table (list of IfxIndexDef), only
+	 * valid if has_index_info is set. Not available for foreign
+	 * tables based on a query.
+	 */
+	bool  has_index_info;
+	List *indexes;
+
+	/*
+	 * Fragments of the remote table in the order of their
+	 * evaluation, only valid if has_fragment_info is set. nfragments
+	 * is 0 for a table which isn't fragmented.
+	 */
+	bool             has_fragment_info;
+	int              nfragments;
+	IfxFragmentInfo *fragments;
 } IfxFdwPlanState;
 
 #endif
 
+/*
+ * Foreign table referenced by an expression deparsed
+ * by ifxDeparseRemoteExpr().
+ */
+typedef struct IfxDeparseRelInfo
+{
+	Index  rtid;            /* range table index of the foreign table */
+	Oid    foreignRelid;    /* OID of the foreign table */
+	char  *alias;           /* table alias used in the remote query, or NULL */
+	List  *shippable_funcs; /* names of user functions shippable to Informix */
+} IfxDeparseRelInfo;
+
 /*
  * PostgreSQL operator types supported for pushdown
  * to an Informix database.
@@ -213,6 +369,8 @@ typedef enum IfxOprType
 	IFX_OPR_GT,
 	IFX_OPR_LT,
 	IFX_OPR_LIKE,
+	IFX_OPR_NOT_LIKE,
+	IFX_OPR_IN,
 	IFX_OPR_AND,
 	IFX_OPR_OR,
 	IFX_OPR_NOT,
@@ -222,6 +380,31 @@ typedef enum IfxOprType
 	IFX_OPR_UNKNOWN
 } IfxOprType;
 
+/*
+ * Maximum number of elements of a single IN (...) list
+ * pushed down to Informix, and the maximum number of array elements
+ * we push down at all. See ifxDeparseScalarArrayOpExpr().
+ */
+#define IFX_IN_LIST_CHUNK_SIZE 1000
+#define IFX_IN_LIST_MAX_ELEMS  10000
+
+/*
+ * A key set is the array of a col = ANY(array) expression too
+ * large for an IN list or only known at execution time. Its
+ * elements are loaded into a TEMP table on the Informix server,
+ * which the pushed down predicate references by a subquery.
+ */
+typedef struct IfxKeySet
+{
+	char *tablename; /* name of the key table */
+	Expr *expr;      /* array expression evaluated into the table */
+} IfxKeySet;
+
+/*
+ * Name of the single column of a key table.
+ */
+#define IFX_KEY_TABLE_COLUMN "ifx_key"
+
 /*
  * Type of deparsed predicate.
  *
@@ -263,6 +446,14 @@ typedef struct IfxPushdownOprContext
 	int   count;         /* number of elements in predicates list */
 	int   count_removed; /* number of removed predicates for FDW pushdown */
 	bool  has_or_expr;
+	List *shippable_funcs; /* user functions shippable to Informix */
+	bool  allow_params;    /* deparse placeholders for params */
+	List *params;          /* expressions bound to placeholders */
+	bool  allow_key_sets;  /* ship large arrays via key tables */
+	List *key_sets;        /* list of IfxKeySet */
+	int   key_set_base;    /* number of key sets of enclosing contexts */
+	int   key_set_refid;   /* statement refid of the scan, names key tables */
+	bool  toplevel;        /* examining a top-level qual, not a BoolExpr argument */
 } IfxPushdownOprContext;
 
 /*
@@ -372,6 +563,9 @@ void setIfxDecimal(IfxFdwExecutionState *state,
 				   TupleTableSlot       *slot,
 				   int attnum);
 
+char *ifxGetRemoteColumnName(Oid foreignTableOid, AttrNumber attnum);
+int ifxGetRemoteIntervalStart(Oid foreignTableOid, AttrNumber attnum);
+
 /*
  * Internal API for PostgreSQL 9.3 and above.
  */
@@ -391,5 +585,20 @@ void ifxGenerateInsertSql(IfxFdwExecutionState *state,
  */
 bool ifx_predicate_tree_walker(Node *node, struct IfxPushdownOprContext *context);
 
+#if PG_VERSION_NUM >= 90200
+char *ifxDeparsePathkeys(RelOptInfo *baserel, Oid foreignRelid,
+						 List *pathkeys, bool nulls_ordering);
+bool ifxIsCompatibleForEquality(Oid typeOid);
+#endif
+
+char *ifxDeparseRemoteExpr(Node *node, List *relinfos, List **params);
+List *ifxParseShippableFunctions(char *value);
+char *ifxParamValueToString(Datum value, Oid typeOid);
+char *ifxKeyTableColumnType(Oid typeOid);
+#if PG_VERSION_NUM >= 90300
+char *ifxDeparseParamJoinClause(Expr *clause, Index rtid,
+								Oid foreignRelid, List **params);
+#endif
+
 #endif
 
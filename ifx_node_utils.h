@@ -42,7 +42,7 @@
  * Number of serialized Const nodes passed
  * from ifxPlanForeignScan()
  */
-#define N_SERIALIZED_FIELDS 11
+#define N_SERIALIZED_FIELDS 14
 
 /*
  * Identifier for serialized Const fields
@@ -61,6 +61,9 @@
 #define SERIALIZED_REFID        8
 #define SERIALIZED_USE_ROWID    9
 #define SERIALIZED_HAS_AFTER_TRIGGERS 10
+#define SERIALIZED_FOREIGN_TABLE_OID 11
+#define SERIALIZED_KEY_TABLES   12
+#define SERIALIZED_BATCH_SIZE   13
 
 #define SERIALIZED_DATA(_vals_) Const * (_vals_)[N_SERIALIZED_FIELDS]
 #define AFFECTED_ATTR_NUMS_IDX (N_SERIALIZED_FIELDS)
@@ -309,8 +309,53 @@ typedef struct IfxPlanData
 	short pagesize;
 	short row_size;
 
+	/*
+	 * Number of fragments of a fragmented table, 0 otherwise.
+	 * nrows and npages are the sums over all fragments then.
+	 */
+	int nfragments;
+
 } IfxPlanData;
 
+/*
+ * Maximum number of columns of an Informix index and
+ * maximum number of indexes retrieved per table.
+ */
+#define IFX_MAX_INDEX_PARTS 16
+#define IFX_MAX_INDEXES     64
+
+/*
+ * Index of a remote table, retrieved from sysindexes
+ * by ifxGetIndexInfo().
+ */
+typedef struct IfxIndexInfo
+{
+	short unique; /* 1 = unique index, 0 = allows duplicates */
+	short nparts; /* number of index columns */
+	char  colnames[IFX_MAX_INDEX_PARTS][IFX_IDENT_MAX_LEN + 1];
+} IfxIndexInfo;
+
+/*
+ * Maximum number of fragments retrieved per table and
+ * maximum length of a fragmentation expression recorded.
+ */
+#define IFX_MAX_FRAGMENTS     256
+#define IFX_FRAGMENT_EXPR_LEN 256
+
+/*
+ * Fragment of a fragmented table, retrieved from sysfragments
+ * by ifxGetFragmentInfo().
+ */
+typedef struct IfxFragmentInfo
+{
+	char   strategy; /* 'E' = expression, 'R' = round robin, ... */
+	int    evalpos;  /* position within the fragment list */
+	double nrows;    /* number of rows, as of UPDATE STATISTICS */
+	double npused;   /* number of pages used */
+	char   partition[IFX_IDENT_MAX_LEN + 1];
+	char   exprtext[IFX_FRAGMENT_EXPR_LEN + 1]; /* empty if none, truncated */
+} IfxFragmentInfo;
+
 /*
  * Foreign scan modes.
  *
@@ -376,6 +421,9 @@ typedef struct IfxConnectionInfo
 	short enable_blobs; /* 0 = no special BLOB support,
 						   1 = special BLOB support */
 	short disable_rowid; /* 1 = disable, 0 enable rowid (default) */
+	char *pushdown_functions; /* user functions shippable to Informix, or NULL */
+	short enable_key_tables; /* 1 = ship large key sets via temp tables */
+	int   batch_size; /* rows per batch in modify actions, 0 = no batching */
 
 	/* plan data */
 	IfxPlanData planData;
@@ -553,6 +601,8 @@ int ifxDescriptorColumnCount(IfxStatementInfo *state);
 void ifxDeclareCursorForPrepared(char *stmt_name, char *cursor_name,
 								 IfxCursorUsage cursorType);
 void ifxOpenCursorForPrepared(IfxStatementInfo *state);
+int ifxOpenCursorForPreparedParams(IfxStatementInfo *state, int nparams,
+								   char **values);
 size_t ifxGetColumnAttributes(IfxStatementInfo *state);
 void ifxFetchRowFromCursor(IfxStatementInfo *state);
 void ifxFetchFirstRowFromCursor(IfxStatementInfo *state);
@@ -566,8 +616,16 @@ char ifxGetSQLCAWarn(signed short warn);
 int ifxGetSQLCAErrd(signed short ca);
 void ifxSetDescriptorCount(char *descr_name, int count);
 void ifxGetSystableStats(char *tablename, IfxPlanData *planData);
+int ifxGetIndexInfo(char *tablename, IfxIndexInfo *indexes, int maxindexes);
+int ifxGetFragmentInfo(char *tablename, IfxFragmentInfo *fragments,
+					   int maxfragments);
+int ifxGetServerVersion(void);
+int ifxGetIntervalQualifierStart(char *tablename, char *colname);
 void ifxPutValuesInPrepared(IfxStatementInfo *state);
 void ifxFlushCursor(IfxStatementInfo *info);
+int ifxSetInsertBufferSize(int size);
+void ifxExecuteImmediate(char *query);
+void ifxLoadKeyTable(char *tablename, int nvalues, char **values);
 IfxIndicatorValue ifxSetSqlVarIndicator(IfxStatementInfo *info, int ifx_attnum,
 										IfxIndicatorValue value);
 void ifxExecuteStmt(IfxStatementInfo *state);
@@ -650,5 +708,6 @@ void ifxSetIntervalFromString(IfxStatementInfo *info, int ifx_attnum,
 
 #define SQLCA_NROWS_PROCESSED 0
 #define SQLCA_NROWS_WEIGHT    3
+#define SQLCA_NROWS_AFFECTED  2
 
 #endif
@@ -19,6 +19,11 @@ static void ifxFdwExecutionStateToList(Const *const_vals[],
 static Datum
 ifxFdwPlanDataAsBytea(IfxConnectionInfo *coninfo);
 
+#if PG_VERSION_NUM >= 90300
+static void
+ifxAppendRowIdCondition(StringInfo sql, IfxFdwExecutionState *state);
+#endif
+
 typedef struct ifxTemporalFormatIdent
 {
 	char *_IFX;
@@ -59,6 +64,49 @@ static ifxTemporalFormatIdent ifxTemporalFormat[] =
 	(((mode) == FMT_PG) ? ifxTemporalFormat[(ident)]._PG \
 	 : ifxTemporalFormat[(ident)]._IFX)
 
+/*
+ * Folds the list of key table names into a comma separated
+ * string, suitable to be serialized into a Const. An empty
+ * list results in an empty string.
+ */
+static char *
+ifxKeyTablesToString(List *key_tables)
+{
+	StringInfoData buf;
+	ListCell      *cell;
+
+	initStringInfo(&buf);
+
+	foreach(cell, key_tables)
+	{
+		if (buf.len > 0)
+			appendStringInfoChar(&buf, ',');
+		appendStringInfoString(&buf, (char *) lfirst(cell));
+	}
+
+	return buf.data;
+}
+
+/*
+ * Reverse operation of ifxKeyTablesToString().
+ */
+static List *
+ifxKeyTablesFromString(char *value)
+{
+	List *result = NIL;
+	char *tablename;
+
+	if (value == NULL)
+		return NIL;
+
+	for (tablename = strtok(pstrdup(value), ",");
+		 tablename != NULL;
+		 tablename = strtok(NULL, ","))
+		result = lappend(result, tablename);
+
+	return result;
+}
+
 /*
  * Deserialize data from fdw_private, passed
  * from the planner via PlanForeignScan().
@@ -96,6 +144,12 @@ void ifxDeserializeFdwData(IfxFdwExecutionState *state,
 															   SERIALIZED_USE_ROWID);
 	state->has_after_row_triggers = ifxGetSerializedInt16Field(params,
 															   SERIALIZED_HAS_AFTER_TRIGGERS);
+	state->foreignTableOid        = (Oid) ifxGetSerializedInt32Field(params,
+																	 SERIALIZED_FOREIGN_TABLE_OID);
+	state->key_tables             = ifxKeyTablesFromString(ifxGetSerializedStringField(params,
+																					   SERIALIZED_KEY_TABLES));
+	state->batch_size             = ifxGetSerializedInt32Field(params,
+															   SERIALIZED_BATCH_SIZE);
 
 	/*
 	 * This has to be the last entry, see ifxSerializedPlanData()
@@ -196,6 +250,15 @@ static void ifxFdwExecutionStateToList(Const *const_vals[],
 
 	const_vals[SERIALIZED_HAS_AFTER_TRIGGERS]
 		= makeFdwInt16Const(state->has_after_row_triggers);
+
+	const_vals[SERIALIZED_FOREIGN_TABLE_OID]
+		= makeFdwInt32Const((int32) state->foreignTableOid);
+
+	const_vals[SERIALIZED_KEY_TABLES]
+		= makeFdwStringConst(ifxKeyTablesToString(state->key_tables));
+
+	const_vals[SERIALIZED_BATCH_SIZE]
+		= makeFdwInt32Const(state->batch_size);
 }
 
 /*
@@ -415,6 +478,31 @@ char *ifxGetIntervalFormatString(IfxTemporalRange range, IfxFormatMode mode)
 
 #if PG_VERSION_NUM >= 90300
 
+/*
+ * Appends the condition identifying the remote target
+ * tuple by its ROWID. A batched modify action (see the
+ * batch_size option) passes a ROWID for each row of the
+ * batch.
+ */
+static void
+ifxAppendRowIdCondition(StringInfo sql, IfxFdwExecutionState *state)
+{
+	int i;
+
+	if (state->batch_size <= 0)
+	{
+		appendStringInfoString(sql, "WHERE rowid = ?");
+		return;
+	}
+
+	appendStringInfoString(sql, "WHERE rowid IN (");
+
+	for (i = 0; i < state->batch_size; i++)
+		appendStringInfoString(sql, (i == 0) ? "?" : ", ?");
+
+	appendStringInfoChar(sql, ')');
+}
+
 /*
  * Generates a SQL statement for DELETE operation on a
  * remote Informix table. Assumes the caller already
@@ -453,7 +541,10 @@ void ifxGenerateDeleteSql(IfxFdwExecutionState *state,
 		appendStringInfo(&sql, " WHERE CURRENT OF %s",
 					 state->stmt_info.cursor_name);
 	else
-		appendStringInfo(&sql, " WHERE rowid = ?");
+	{
+		appendStringInfoChar(&sql, ' ');
+		ifxAppendRowIdCondition(&sql, state);
+	}
 
 	state->stmt_info.query = sql.data;
 }
@@ -519,7 +610,7 @@ void ifxGenerateUpdateSql(IfxFdwExecutionState *state,
 	if (coninfo->disable_rowid)
 		appendStringInfo(&sql, "WHERE CURRENT OF %s", state->stmt_info.cursor_name);
 	else
-		appendStringInfo(&sql, "WHERE rowid = ?");
+		ifxAppendRowIdCondition(&sql, state);
 
 	/*
 	 * And we're done.
@@ -266,19 +266,189 @@ CLOSE cur;
 
 COMMIT;
 
+--
+-- Pushdown of query parts to the Informix server. EXPLAIN (VERBOSE)
+-- shows the generated remote query, costs depend on the server.
+--
+
+-- ORDER BY
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1, flag FROM serial_test ORDER BY f1 DESC;
+SELECT f1, flag FROM serial_test ORDER BY f1 DESC;
+
+-- LIMIT, OFFSET rows are fetched, too
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1 FROM serial_test ORDER BY f1 LIMIT 2 OFFSET 1;
+SELECT f1 FROM serial_test ORDER BY f1 LIMIT 2 OFFSET 1;
+
+-- Aggregates, GROUP BY and HAVING
+EXPLAIN (VERBOSE, COSTS OFF) SELECT count(*), min(f1), max(f1) FROM serial_test;
+SELECT count(*), min(f1), max(f1) FROM serial_test;
+EXPLAIN (VERBOSE, COSTS OFF) SELECT flag, count(*) FROM serial_test GROUP BY flag HAVING count(*) > 1;
+SELECT flag, count(*) FROM serial_test GROUP BY flag HAVING count(*) > 1;
+
+-- Join of two foreign tables
+EXPLAIN (VERBOSE, COSTS OFF) SELECT s1.id, s2.name FROM bar_serial s1 JOIN bar_serial s2 ON (s1.id = s2.id);
+SELECT s1.id, s2.name FROM bar_serial s1 JOIN bar_serial s2 ON (s1.id = s2.id);
+
+-- Foreign table as inheritance child, scanned as a plain foreign table
+CREATE TABLE ifx_parent(id integer NOT NULL, name varchar(100));
+CREATE FOREIGN TABLE ifx_child() INHERITS (ifx_parent)
+SERVER test_server
+OPTIONS(database :'INFORMIXDB',
+        client_locale :'CLIENT_LOCALE',
+        db_locale :'DB_LOCALE',
+        table 'bar_serial');
+INSERT INTO ifx_parent VALUES(2, 'bernhard'), (3, 'other');
+EXPLAIN (VERBOSE, COSTS OFF) SELECT id, name FROM ifx_parent WHERE name ~ 'bern';
+SELECT id, name FROM ifx_parent WHERE name ~ 'bern' ORDER BY id;
+DROP FOREIGN TABLE ifx_child;
+DROP TABLE ifx_parent;
+
+-- Boolean expressions with a predicate not shippable to Informix
+CREATE FUNCTION ifx_is_even(bigint) RETURNS boolean
+AS $$ BEGIN RETURN $1 % 2 = 0; END; $$ LANGUAGE plpgsql IMMUTABLE;
+-- OR with an unshippable branch is evaluated locally
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1, f2, f3 FROM inttest WHERE f1 BETWEEN 1 AND 6 AND (f1 = 1 OR ifx_is_even(f1));
+SELECT f1, f2, f3 FROM inttest WHERE f1 BETWEEN 1 AND 6 AND (f1 = 1 OR ifx_is_even(f1)) ORDER BY f1;
+-- NOT over an AND with an unshippable argument, the planner turns it
+-- into an OR evaluated locally, too
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1, f2, f3 FROM inttest WHERE f1 BETWEEN 1 AND 6 AND NOT (f1 > 3 AND ifx_is_even(f1));
+SELECT f1, f2, f3 FROM inttest WHERE f1 BETWEEN 1 AND 6 AND NOT (f1 > 3 AND ifx_is_even(f1)) ORDER BY f1;
+-- AND, only the shippable conditions are pushed down
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1, f2, f3 FROM inttest WHERE f1 > 0 AND ifx_is_even(f1) AND f2 = 120 AND f1 < 5;
+SELECT f1, f2, f3 FROM inttest WHERE f1 > 0 AND ifx_is_even(f1) AND f2 = 120 AND f1 < 5 ORDER BY f1;
+DROP FUNCTION ifx_is_even(bigint);
+
+-- IN list
+EXPLAIN (VERBOSE, COSTS OFF) SELECT id, name FROM bar_serial WHERE id IN (1, 2, 3);
+SELECT id, name FROM bar_serial WHERE id IN (1, 2, 3);
+
+-- DATE constant, applied to the result of the query option
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f3, f4 FROM datetime_test WHERE f3 = DATE '2012-04-20';
+SELECT f3, f4 FROM datetime_test WHERE f3 = DATE '2012-04-20';
+
+-- Function call
+EXPLAIN (VERBOSE, COSTS OFF) SELECT id, name FROM bar_serial WHERE abs(id) = 1;
+SELECT id, name FROM bar_serial WHERE abs(id) = 1;
+
+-- Arithmetic and column comparison
+EXPLAIN (VERBOSE, COSTS OFF) SELECT f1 FROM serial_test WHERE f1 * 2 = f1 + 1;
+SELECT f1 FROM serial_test WHERE f1 * 2 = f1 + 1;
+
+-- Stable expression passed as a placeholder
+EXPLAIN (VERBOSE, COSTS OFF) SELECT count(*) FROM datetime_test WHERE f3 < current_date;
+SELECT count(*) FROM datetime_test WHERE f3 < current_date;
+
+-- Columns mapped to differently named remote columns
+CREATE FOREIGN TABLE bar_renamed(bar_id integer OPTIONS(column_name 'id'),
+                                  bar_name varchar(100) OPTIONS(column_name 'name'))
+SERVER test_server
+OPTIONS(database :'INFORMIXDB',
+        client_locale :'CLIENT_LOCALE',
+        db_locale :'DB_LOCALE',
+        table 'bar_serial');
+EXPLAIN (VERBOSE, COSTS OFF) SELECT bar_id, bar_name FROM bar_renamed WHERE bar_id = 1;
+SELECT bar_id, bar_name FROM bar_renamed WHERE bar_id = 1;
+DROP FOREIGN TABLE bar_renamed;
+
+-- A query with a WHERE clause of its own is wrapped into a derived table
+CREATE FOREIGN TABLE bar_query(id integer, name varchar(100))
+SERVER test_server
+OPTIONS(database :'INFORMIXDB',
+        client_locale :'CLIENT_LOCALE',
+        db_locale :'DB_LOCALE',
+        query 'SELECT id, name FROM bar_serial WHERE id > 0');
+EXPLAIN (VERBOSE, COSTS OFF) SELECT id, name FROM bar_query WHERE id = 1;
+SELECT id, name FROM bar_query WHERE id = 1;
+DROP FOREIGN TABLE bar_query;
+
+-- SELECT DISTINCT
+EXPLAIN (VERBOSE, COSTS OFF) SELECT DISTINCT id FROM bar_serial;
+SELECT DISTINCT id FROM bar_serial;
+
+-- Parameterized path, the join key of the outer relation is passed
+-- as a placeholder using the index on inttest.f1
+CREATE TABLE local_ids(id integer);
+INSERT INTO local_ids VALUES (101), (102);
+ANALYZE local_ids;
+SET enable_hashjoin TO off;
+SET enable_mergejoin TO off;
+EXPLAIN (VERBOSE, COSTS OFF) SELECT l.id, i.f2, i.f3 FROM local_ids l JOIN inttest i ON (i.f1 = l.id);
+SELECT l.id, i.f2, i.f3 FROM local_ids l JOIN inttest i ON (i.f1 = l.id);
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+DROP TABLE local_ids;
+
+-- Key tables, cursors open at the same time use a key table each
+ALTER FOREIGN TABLE inttest OPTIONS(ADD enable_key_tables '1');
+SELECT array_agg(g) AS keys1 FROM generate_series(1, 2000) AS g \gset
+SELECT array_agg(g) AS keys2 FROM generate_series(1001, 3000) AS g \gset
+BEGIN;
+DECLARE c1 CURSOR FOR SELECT count(*), min(f1), max(f1) FROM inttest WHERE f1 = ANY(:'keys1'::bigint[]);
+DECLARE c2 CURSOR FOR SELECT count(*), min(f1), max(f1) FROM inttest WHERE f1 = ANY(:'keys2'::bigint[]);
+FETCH c1;
+FETCH c2;
+CLOSE c1;
+CLOSE c2;
+COMMIT;
+ALTER FOREIGN TABLE inttest OPTIONS(DROP enable_key_tables);
+
+-- Without a remote index on the join column, the foreign table isn't
+-- scanned for each outer row, but once
+CREATE TABLE local_f2(id integer);
+INSERT INTO local_f2 VALUES (7), (200);
+ANALYZE local_f2;
+SET enable_hashjoin TO off;
+SET enable_mergejoin TO off;
+EXPLAIN (VERBOSE, COSTS OFF) SELECT l.id, i.f1 FROM local_f2 l LEFT JOIN inttest i ON (i.f2 = l.id);
+SELECT l.id, i.f1 FROM local_f2 l LEFT JOIN inttest i ON (i.f2 = l.id) ORDER BY l.id;
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+DROP TABLE local_f2;
+
 --
 -- Test ANALYZE
 --
 
--- should succeed, but with a no-op, since text_test
--- is based on a query.
+-- should succeed, text_test is based on a query, whose
+-- rows are all fetched
 SET client_min_messages TO WARNING;
 ANALYZE VERBOSE text_test;
+SELECT reltuples FROM pg_class WHERE relname = 'text_test';
 SET client_min_messages TO ERROR;
 
 -- should succeed
 ANALYZE inttest;
 
+-- ANALYZE with a column list fetches only these columns. name is
+-- too short for the remote values, thus fails to convert otherwise.
+CREATE FOREIGN TABLE bar_short(id integer, name varchar(2))
+SERVER test_server
+OPTIONS(database :'INFORMIXDB',
+        client_locale :'CLIENT_LOCALE',
+        db_locale :'DB_LOCALE',
+        table 'bar_serial');
+ANALYZE bar_short(id);
+SELECT attname FROM pg_stats WHERE tablename = 'bar_short' ORDER BY attname;
+ANALYZE bar_short;
+DROP FOREIGN TABLE bar_short;
+
+-- Without a usable ROWID, ANALYZE samples all rows locally
+CREATE FOREIGN TABLE inttest_norowid(f1 bigint, f2 integer, f3 smallint)
+SERVER test_server
+OPTIONS(database :'INFORMIXDB',
+        client_locale :'CLIENT_LOCALE',
+        db_locale :'DB_LOCALE',
+        table 'inttest',
+        disable_rowid '1');
+SET default_statistics_target TO 10;
+ANALYZE VERBOSE inttest_norowid;
+RESET default_statistics_target;
+DROP FOREIGN TABLE inttest_norowid;
+
+-- inttest isn't fragmented on the Informix server, its row count
+-- recorded by ANALYZE above is the number of rows fetched
+SELECT reltuples FROM pg_class WHERE relname = 'inttest';
+
 --
 -- ALTER FOREIGN TABLE ... DROP COLUMN
 --
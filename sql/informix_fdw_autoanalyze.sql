@@ -0,0 +1,39 @@
+--
+-- Regression tests for the autoanalyze background worker.
+--
+-- NOTE:
+--
+-- This test requires the server to be started with
+--
+--   shared_preload_libraries = 'ifx_fdw'
+--   informix_fdw.autoanalyze_database = 'postgres'
+--
+-- in postgresql.conf, otherwise the settings aren't defined and
+-- the worker isn't running. The worker can't use the regression
+-- database, since it would prevent it from being dropped.
+--
+
+--
+-- Settings of the worker, defined by the preloaded library
+--
+SHOW informix_fdw.autoanalyze_database;
+SHOW informix_fdw.autoanalyze_naptime;
+SHOW informix_fdw.autoanalyze_scale_factor;
+SHOW informix_fdw.autoanalyze_max_per_server;
+
+--
+-- None of them can be changed within a session
+--
+SET informix_fdw.autoanalyze_database TO 'contrib_regression';
+SET informix_fdw.autoanalyze_naptime TO 10;
+SET informix_fdw.autoanalyze_max_per_server TO 0;
+
+--
+-- The worker is registered and connected to its database
+--
+SELECT datname, backend_type FROM pg_stat_activity
+WHERE backend_type = 'informix_fdw autoanalyze';
+
+--
+-- Done.
+--
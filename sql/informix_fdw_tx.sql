@@ -682,6 +682,60 @@ COMMIT;
 --
 ALTER FOREIGN TABLE inttest OPTIONS(DROP disable_rowid);
 
+--------------------------------------------------------------------------------
+-- UPDATE and DELETE executed as a single statement on the Informix server
+--------------------------------------------------------------------------------
+
+BEGIN;
+
+INSERT INTO inttest VALUES(1, 2, 3), (4, 5, 6), (7, 8, 9);
+
+EXPLAIN (VERBOSE, COSTS OFF) UPDATE inttest SET f2 = 10 WHERE f2 = 5;
+UPDATE inttest SET f2 = 10 WHERE f2 = 5;
+
+SELECT f1, f2, f3 FROM inttest ORDER BY f1;
+
+EXPLAIN (VERBOSE, COSTS OFF) DELETE FROM inttest WHERE f2 = 10;
+DELETE FROM inttest WHERE f2 = 10;
+
+SELECT f1, f2, f3 FROM inttest ORDER BY f1;
+
+DELETE FROM inttest;
+
+COMMIT;
+
+--------------------------------------------------------------------------------
+-- Batched INSERT
+--------------------------------------------------------------------------------
+
+ALTER FOREIGN TABLE inttest OPTIONS(ADD batch_size '2');
+
+BEGIN;
+
+-- The insert buffer holds two rows, the last row is flushed at the end
+EXPLAIN (VERBOSE, COSTS OFF) INSERT INTO inttest SELECT t.id, t.id, t.id FROM generate_series(1, 5) AS t(id);
+INSERT INTO inttest SELECT t.id, t.id, t.id FROM generate_series(1, 5) AS t(id);
+
+SELECT f1, f2, f3 FROM inttest ORDER BY f1;
+
+-- UPDATE and DELETE with a join, sent in batches of ROWIDs
+CREATE TEMP TABLE local_inttest(id integer) ON COMMIT DROP;
+INSERT INTO local_inttest VALUES(2), (3), (4);
+
+UPDATE inttest SET f3 = 0 FROM local_inttest t WHERE t.id = inttest.f1;
+
+SELECT f1, f2, f3 FROM inttest ORDER BY f1;
+
+DELETE FROM inttest USING local_inttest t WHERE t.id = inttest.f1;
+
+SELECT f1, f2, f3 FROM inttest ORDER BY f1;
+
+DELETE FROM inttest;
+
+COMMIT;
+
+ALTER FOREIGN TABLE inttest OPTIONS(DROP batch_size);
+
 --------------------------------------------------------------------------------
 -- Regression Tests End, Cleanup
 --------------------------------------------------------------------------------